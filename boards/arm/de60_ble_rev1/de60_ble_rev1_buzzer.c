@@ -7,20 +7,49 @@
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
 #include <zmk/event_manager.h>
-#include <zmk/events/ble_active_profile_changed.h>
-#include <zmk/events/endpoint_changed.h>
-#include <zmk/ble.h>
-#include <zmk/endpoints.h>
+
+#if IS_ENABLED(CONFIG_DEEMEN17_BUZZER_CLICK)
+#include <zmk/events/position_state_changed.h>
+#include <zmk/usb.h>
+#if IS_ENABLED(CONFIG_ZMK_BATTERY_REPORTING)
+#include <zmk/events/battery_state_changed.h>
+#endif
+#endif
+
+#include <deemen17/boot_profile.h>
+#include <deemen17/conn_state.h>
+#include <deemen17/energy.h>
+#include <deemen17/fast_resume.h>
+#include <deemen17/feedback.h>
+#include <deemen17/listener_profile.h>
+#include <deemen17/pwm_seq.h>
+#include <deemen17/sound_request.h>
 
 #define BUZZER_NODE DT_ALIAS(buzzer)
 
 #if DT_NODE_HAS_STATUS(BUZZER_NODE, okay)
 
+// Controllers that can play a whole melody from a sequence buffer, with one
+// interrupt at the end instead of a wakeup per note
+#define BUZZER_PWM_CTLR DT_PWMS_CTLR(BUZZER_NODE)
+#define BUZZER_PWM_SEQ                                                                             \
+    (IS_ENABLED(CONFIG_DEEMEN17_BUZZER_PWM_SEQ) &&                                                 \
+     (DT_NODE_HAS_COMPAT(BUZZER_PWM_CTLR, deemen17_nrf_pwm_seq) ||                                 \
+      DT_NODE_HAS_COMPAT(BUZZER_PWM_CTLR, deemen17_pwm_sim)))
+
+// Every note retimes the whole instance, so other users of the buzzer's PWM controller
+// need one that keeps their duty cycle across period changes
+#define BUZZER_SHARES_CTLR(node) || DT_SAME_NODE(DT_PWMS_CTLR(node), BUZZER_PWM_CTLR)
+#define PWM_LEDS_SHARE_BUZZER_CTLR(leds) DT_FOREACH_CHILD_STATUS_OKAY(leds, BUZZER_SHARES_CTLR)
+
+BUILD_ASSERT(DT_NODE_HAS_COMPAT(BUZZER_PWM_CTLR, deemen17_nrf_pwm_seq) ||
+                 DT_NODE_HAS_COMPAT(BUZZER_PWM_CTLR, deemen17_pwm_sim) ||
+                 !(0 DT_FOREACH_STATUS_OKAY(pwm_leds, PWM_LEDS_SHARE_BUZZER_CTLR)),
+             "PWM LEDs share the buzzer's PWM instance, move the buzzer to its own");
+
 // Optimized buzzer configuration
-#define BUZZER_THREAD_STACK_SIZE 1024
-#define BUZZER_THREAD_PRIORITY K_PRIO_COOP(8)
-#define BLE_MONITOR_INTERVAL_MS 3000
 #define MAX_BLE_PROFILES 5
+#define MAX_MELODY_NOTES 5
 
 // Musical note periods in nanoseconds (optimized for memory)
 typedef struct {
@@ -43,114 +72,258 @@ enum musical_notes {
     NOTE_SILENT = 0    // Silence
 };
 
-// Buzzer state management with anti-spam protection
+// Sound request classes, in ascending priority order
+typedef enum {
+    SOUND_CLASS_STARTUP,
+    SOUND_CLASS_CONNECTION,
+    SOUND_CLASS_ENDPOINT,
+    SOUND_CLASS_PROFILE,
+    SOUND_CLASS_COUNT,
+} sound_class_t;
+
+enum endpoint_sound {
+    ENDPOINT_SOUND_USB,
+    ENDPOINT_SOUND_BLE,
+};
+
+// Melody sequencer state, only touched from feedback jobs
+typedef struct {
+    const buzzer_note_t *melody;
+    sound_class_t sound_class;
+    size_t note_count;
+    size_t next_note;
+    bool in_gap;         // Currently in the silent gap after a note
+    bool hw;             // Played by the PWM peripheral as one sequence
+    uint32_t generation; // Tags this play, completions of older ones are ignored
+} buzzer_seq_t;
+
+// Buzzer state management
 typedef struct {
     bool is_playing;
     bool hw_ready;
-    uint8_t current_profile;
-    bool connection_states[MAX_BLE_PROFILES];
-    struct k_work_q work_queue;
-    K_THREAD_STACK_MEMBER(work_stack, BUZZER_THREAD_STACK_SIZE);
-
-    // Anti-spam protection
-    uint32_t last_profile_change;  // Timestamp of last profile change
-    uint32_t last_endpoint_change; // Timestamp of last endpoint change
-    uint32_t last_sound_played;    // Timestamp of last sound played
-    uint8_t spam_counter;          // Count rapid events
-    bool spam_mode;                // In spam protection mode
+
+    // Non-blocking melody playback
+    buzzer_seq_t seq;
+    struct feedback_job seq_job;
+    uint32_t generation;
+    atomic_t hw_done; // Generation of the last PWM sequence that played to the end
 } buzzer_state_t;
 
 static buzzer_state_t buzzer_state = {0};
 
-// Anti-spam configuration
-#define MIN_PROFILE_INTERVAL_MS 300  // Minimum 300ms between profile sounds
-#define MIN_ENDPOINT_INTERVAL_MS 500 // Minimum 500ms between endpoint sounds
-#define MIN_SOUND_INTERVAL_MS 100    // Minimum 100ms between any sounds
-#define SPAM_THRESHOLD 5             // 5 rapid events = spam detected
-#define SPAM_COOLDOWN_MS 2000        // 2 second cooldown in spam mode
+#define NOTE_GAP_MS 10               // Silence between consecutive notes
+#define SOUND_REQ_SLACK_MS 20        // Scheduling slack for starting a requested sound
+#define STARTUP_CHIME_DELAY_MS 300   // Let the supply settle before the first melody
+#define SILENCE_PERIOD_NS 1250000    // Period of silent sequence steps, 8 to a gap
+
+#define SOUND_REQ_MAX_AGE_MS 1000 // Requests waiting longer than this are dropped
+
+BUILD_ASSERT(SOUND_CLASS_COUNT <= SOUND_MAILBOX_MAX_CLASSES, "Too many sound classes");
+
+static struct sound_mailbox sound_requests =
+    SOUND_MAILBOX_INITIALIZER(SOUND_CLASS_COUNT, SOUND_REQ_MAX_AGE_MS);
+
+static void sound_request_work(struct feedback_job *job);
+static FEEDBACK_JOB_DEFINE(sound_job, sound_request_work);
 
 static const struct pwm_dt_spec pwm = PWM_DT_SPEC_GET(BUZZER_NODE);
 
-// Anti-spam protection functions
-static bool is_spam_detected(uint32_t now, uint32_t last_event, uint32_t min_interval) {
-    if (now - last_event < min_interval) {
-        buzzer_state.spam_counter++;
-        if (buzzer_state.spam_counter >= SPAM_THRESHOLD) {
-            buzzer_state.spam_mode = true;
-            LOG_WRN("Spam detected! Activating protection mode");
-            return true;
-        }
-    } else {
-        buzzer_state.spam_counter = 0;
+// Each class only touches its own bucket
+static const struct sound_limit sound_limits[SOUND_CLASS_COUNT] = {
+    [SOUND_CLASS_STARTUP] = {0, 0},
+    [SOUND_CLASS_CONNECTION] = {CONFIG_DEEMEN17_BUZZER_CONNECTION_BURST,
+                                CONFIG_DEEMEN17_BUZZER_CONNECTION_REFILL_MS},
+    [SOUND_CLASS_ENDPOINT] = {CONFIG_DEEMEN17_BUZZER_ENDPOINT_BURST,
+                              CONFIG_DEEMEN17_BUZZER_ENDPOINT_REFILL_MS},
+    [SOUND_CLASS_PROFILE] = {CONFIG_DEEMEN17_BUZZER_PROFILE_BURST,
+                             CONFIG_DEEMEN17_BUZZER_PROFILE_REFILL_MS},
+};
+
+static struct sound_bucket sound_buckets[SOUND_CLASS_COUNT];
+
+static bool sound_rate_ok(sound_class_t sound_class) {
+    struct sound_bucket *bucket = &sound_buckets[sound_class];
+
+    if (!sound_bucket_take(bucket, &sound_limits[sound_class], k_uptime_get_32())) {
+        LOG_DBG("Sound class %d rate limited, %u dropped", sound_class, bucket->dropped);
+        return false;
     }
-    return false;
+
+    return true;
 }
 
-static bool should_block_sound(uint32_t now, uint32_t last_event, uint32_t min_interval) {
-    // Block if in spam mode and cooldown not finished
-    if (buzzer_state.spam_mode && (now - buzzer_state.last_sound_played < SPAM_COOLDOWN_MS)) {
-        return true;
-    }
+static inline void buzzer_silence(void) { pwm_set_dt(&pwm, 0, 0); }
 
-    // Block if too frequent
-    if (now - last_event < min_interval) {
-        return true;
-    }
+static void buzzer_seq_finish(void) {
+    buzzer_silence();
+    buzzer_state.seq.melody = NULL;
+    buzzer_state.is_playing = false;
+    energy_source_set(ENERGY_SOURCE_BUZZER, false);
+}
+
+#if BUZZER_PWM_SEQ
+// The sequence controller holds each buffer entry for this many periods
+#define SEQ_BLOCK_PERIODS (DT_PROP_OR(BUZZER_PWM_CTLR, refresh, 0) + 1)
+#define GAP_PERIODS (NOTE_GAP_MS * NSEC_PER_MSEC / SILENCE_PERIOD_NS)
+
+BUILD_ASSERT(GAP_PERIODS * SILENCE_PERIOD_NS == NOTE_GAP_MS * NSEC_PER_MSEC &&
+                 GAP_PERIODS % SEQ_BLOCK_PERIODS == 0,
+             "The note gap must be whole blocks of silent periods");
+
+static struct pwm_seq_step hw_steps[2 * MAX_MELODY_NOTES];
+
+// Whole blocks of periods closest to the duration, at least one block
+static uint32_t buzzer_seq_periods(uint32_t duration_ms, uint32_t period_ns) {
+    uint64_t block_ns = (uint64_t)period_ns * SEQ_BLOCK_PERIODS;
+    uint32_t blocks = DIV_ROUND_CLOSEST((uint64_t)duration_ms * NSEC_PER_MSEC, block_ns);
 
-    // Exit spam mode after cooldown
-    if (buzzer_state.spam_mode && (now - buzzer_state.last_sound_played >= SPAM_COOLDOWN_MS)) {
-        buzzer_state.spam_mode = false;
-        buzzer_state.spam_counter = 0;
-        LOG_INF("Exiting spam protection mode");
+    return MAX(1U, blocks) * SEQ_BLOCK_PERIODS;
+}
+
+// Turn a melody into notes and gaps, each held for whole blocks of its own periods
+static size_t buzzer_seq_compile(const buzzer_note_t *melody, size_t note_count) {
+    size_t steps = 0;
+
+    for (size_t i = 0; i < note_count && steps < ARRAY_SIZE(hw_steps); i++) {
+        uint32_t period_ns = melody[i].period_ns ? melody[i].period_ns : SILENCE_PERIOD_NS;
+
+        hw_steps[steps++] = (struct pwm_seq_step){
+            .period_ns = period_ns,
+            .pulse_ns = melody[i].period_ns / 2U,
+            .periods = buzzer_seq_periods(melody[i].duration_ms, period_ns),
+        };
+
+        if (i + 1 < note_count && steps < ARRAY_SIZE(hw_steps)) {
+            hw_steps[steps++] = (struct pwm_seq_step){
+                .period_ns = SILENCE_PERIOD_NS,
+                .pulse_ns = 0,
+                .periods = GAP_PERIODS,
+            };
+        }
     }
 
-    return false;
+    return steps;
 }
 
-static void update_sound_timestamp(void) { buzzer_state.last_sound_played = k_uptime_get_32(); }
+// PWM interrupt: the whole melody has played, finish it from the feedback executor
+static void buzzer_seq_hw_done(const struct device *dev, void *user_data) {
+    atomic_set(&buzzer_state.hw_done, POINTER_TO_UINT(user_data));
+    feedback_job_schedule(&buzzer_state.seq_job, 0, 0);
+}
 
-// Optimized tone playing with non-blocking approach
-static inline void play_tone_async(uint32_t period_ns, uint8_t duration_ms) {
-    if (!buzzer_state.hw_ready || buzzer_state.is_playing) {
-        return;
+static bool buzzer_seq_start_hw(void) {
+    buzzer_seq_t *seq = &buzzer_state.seq;
+    size_t steps = buzzer_seq_compile(seq->melody, seq->note_count);
+    int err;
+
+    seq->hw = true;
+    err = pwm_seq_play(pwm.dev, pwm.channel, pwm.flags, hw_steps, steps, buzzer_seq_hw_done,
+                       UINT_TO_POINTER(seq->generation));
+    if (err) {
+        LOG_DBG("PWM sequence playback failed (%d), stepping notes instead", err);
+        seq->hw = false;
     }
 
-    buzzer_state.is_playing = true;
-    pwm_set_dt(&pwm, period_ns, period_ns / 2U);
-    k_msleep(duration_ms);
-    pwm_set_dt(&pwm, 0, 0);
-    buzzer_state.is_playing = false;
+    return seq->hw;
 }
+#endif
 
-// Optimized sequence player with anti-spam protection
-static void play_melody(const buzzer_note_t *melody, size_t note_count) {
-    uint32_t now = k_uptime_get_32();
+// Sequencer step: starts the next note or gap and re-arms itself, never sleeps
+static void buzzer_seq_step(struct feedback_job *job) {
+    buzzer_seq_t *seq = &buzzer_state.seq;
 
-    if (!buzzer_state.hw_ready) {
+    if (!seq->melody || !buzzer_state.hw_ready) {
         return;
     }
 
-    // Check if sound should be blocked due to spam
-    if (should_block_sound(now, buzzer_state.last_sound_played, MIN_SOUND_INTERVAL_MS)) {
-        LOG_DBG("Sound blocked due to anti-spam protection");
+    if (seq->hw) {
+        if (atomic_get(&buzzer_state.hw_done) != seq->generation) {
+            // Completion of a melody that was cancelled, this one still plays
+            return;
+        }
+
+        // The PWM peripheral played the whole melody
+        buzzer_seq_finish();
+        feedback_job_schedule(&sound_job, 0, SOUND_REQ_SLACK_MS);
         return;
     }
 
-    // Play melody if not blocked
-    for (size_t i = 0; i < note_count && buzzer_state.hw_ready; i++) {
-        if (buzzer_state.spam_mode) {
-            // In spam mode, play shorter/quieter sounds
-            uint8_t reduced_duration = melody[i].duration_ms / 2;
-            play_tone_async(melody[i].period_ns, reduced_duration);
+    if (!seq->in_gap && seq->next_note > 0) {
+        // Note finished, hold a short silence before the next one
+        buzzer_silence();
+        seq->in_gap = true;
+        feedback_job_schedule(job, NOTE_GAP_MS, 0);
+    } else if (seq->next_note < seq->note_count) {
+        const buzzer_note_t *note = &seq->melody[seq->next_note++];
+        uint8_t duration_ms = note->duration_ms;
+
+        if (note->period_ns == NOTE_SILENT) {
+            buzzer_silence();
         } else {
-            play_tone_async(melody[i].period_ns, melody[i].duration_ms);
+            pwm_set_dt(&pwm, note->period_ns, note->period_ns / 2U);
         }
-        k_msleep(10); // Shorter gap in spam mode
+        seq->in_gap = false;
+        feedback_job_schedule(job, duration_ms, 0);
+    } else {
+        buzzer_seq_finish();
+        // Pick up requests that were waiting behind this melody
+        feedback_job_schedule(&sound_job, 0, SOUND_REQ_SLACK_MS);
     }
+}
 
-    update_sound_timestamp();
+// Stop any melody in progress and silence the buzzer
+static void buzzer_seq_cancel(void) {
+#if BUZZER_PWM_SEQ
+    // Stop first: once stopped no completion can schedule the job cancelled below
+    if (buzzer_state.seq.melody && buzzer_state.seq.hw) {
+        pwm_seq_stop(pwm.dev);
+    }
+#endif
+    feedback_job_cancel(&buzzer_state.seq_job);
+    if (buzzer_state.seq.melody) {
+        buzzer_seq_finish();
+    }
+}
+
+// Start a melody, preempting the one currently playing. Must run from a feedback job.
+static void buzzer_seq_start(const buzzer_note_t *melody, size_t note_count,
+                             sound_class_t sound_class) {
+    if (buzzer_state.is_playing) {
+        LOG_DBG("Preempting melody in progress");
+        buzzer_seq_cancel();
+    }
+
+    buzzer_state.seq = (buzzer_seq_t){
+        .melody = melody,
+        .sound_class = sound_class,
+        .note_count = note_count,
+        .next_note = 0,
+        .in_gap = false,
+        .hw = false,
+        .generation = ++buzzer_state.generation,
+    };
+    buzzer_state.is_playing = true;
+    energy_source_set(ENERGY_SOURCE_BUZZER, true);
+
+#if BUZZER_PWM_SEQ
+    if (buzzer_seq_start_hw()) {
+        return;
+    }
+#endif
+
+    feedback_job_schedule(&buzzer_state.seq_job, 0, 0);
+}
+
+// Sequence player; requests were rate limited by their class when posted
+static void play_melody(const buzzer_note_t *melody, size_t note_count,
+                        sound_class_t sound_class) {
+    if (!buzzer_state.hw_ready) {
+        return;
+    }
+
+    buzzer_seq_start(melody, note_count, sound_class);
 } // Optimized profile sounds using structured melodies
-static const buzzer_note_t profile_melodies[][5] = {
+static const buzzer_note_t profile_melodies[][MAX_MELODY_NOTES] = {
     // Profile 1 - Single note
     {{NOTE_C5, 100}, {NOTE_SILENT, 0}},
 
@@ -176,208 +349,220 @@ static const buzzer_note_t ble_melody[] = {{NOTE_G5, 90}, {NOTE_A5, 90}, {NOTE_B
 static const buzzer_note_t ble_connected_melody[] = {
     {NOTE_C5, 70}, {NOTE_E5, 70}, {NOTE_G5, 70}, {NOTE_A5, 70}};
 
-// Work queue functions for non-blocking audio
-static void profile_sound_work(struct k_work *work);
-static void system_sound_work(struct k_work *work);
-static void connection_sound_work(struct k_work *work);
-
-K_WORK_DEFINE(profile_work, profile_sound_work);
-K_WORK_DEFINE(system_work, system_sound_work);
-K_WORK_DEFINE(connection_work, connection_sound_work);
-
-static uint8_t pending_profile = 0;
-static uint8_t pending_system_sound = 0; // 1=startup, 2=usb, 3=ble
-
-// Work queue implementations for non-blocking audio
-static void profile_sound_work(struct k_work *work) {
-    if (pending_profile < 5) {
-        size_t melody_len = 0;
-        // Calculate melody length
-        for (int i = 0; i < 5; i++) {
-            if (profile_melodies[pending_profile][i].period_ns == NOTE_SILENT) {
-                break;
-            }
-            melody_len++;
+static size_t profile_melody_len(uint8_t profile_idx) {
+    size_t melody_len = 0;
+
+    for (int i = 0; i < ARRAY_SIZE(profile_melodies[0]); i++) {
+        if (profile_melodies[profile_idx][i].period_ns == NOTE_SILENT) {
+            break;
         }
-        play_melody(profile_melodies[pending_profile], melody_len);
-        LOG_INF("Profile %d sound played", pending_profile + 1);
+        melody_len++;
     }
+
+    return melody_len;
 }
 
-static void system_sound_work(struct k_work *work) {
-    switch (pending_system_sound) {
-    case 1: // Startup
-        play_melody(startup_melody, ARRAY_SIZE(startup_melody));
-        LOG_INF("Startup sound played");
+// Producer side: never blocks or allocates, safe from any listener context.
+// A newer request of the same class replaces the pending one (latest wins).
+static void sound_request_post(sound_class_t sound_class, uint8_t arg) {
+    sound_mailbox_post(&sound_requests, sound_class, arg, k_uptime_get_32());
+    feedback_job_schedule(&sound_job, 0, SOUND_REQ_SLACK_MS);
+}
+
+static void play_sound_request(sound_class_t sound_class, uint8_t arg) {
+    switch (sound_class) {
+    case SOUND_CLASS_PROFILE:
+        if (arg < ARRAY_SIZE(profile_melodies)) {
+            play_melody(profile_melodies[arg], profile_melody_len(arg), sound_class);
+            LOG_INF("Profile %d sound played", arg + 1);
+        }
         break;
-    case 2: // USB
-        play_melody(usb_melody, ARRAY_SIZE(usb_melody));
-        LOG_INF("USB sound played");
+    case SOUND_CLASS_ENDPOINT:
+        if (arg == ENDPOINT_SOUND_USB) {
+            play_melody(usb_melody, ARRAY_SIZE(usb_melody), sound_class);
+            LOG_INF("USB sound played");
+        } else {
+            play_melody(ble_melody, ARRAY_SIZE(ble_melody), sound_class);
+            LOG_INF("BLE sound played");
+        }
+        break;
+    case SOUND_CLASS_CONNECTION:
+        play_melody(ble_connected_melody, ARRAY_SIZE(ble_connected_melody), sound_class);
+        LOG_INF("BLE connected sound played");
+        break;
+    case SOUND_CLASS_STARTUP:
+        play_melody(startup_melody, ARRAY_SIZE(startup_melody), sound_class);
+        LOG_INF("Startup sound played");
         break;
-    case 3: // BLE
-        play_melody(ble_melody, ARRAY_SIZE(ble_melody));
-        LOG_INF("BLE sound played");
+    default:
         break;
     }
-    pending_system_sound = 0;
 }
 
-static void connection_sound_work(struct k_work *work) {
-    play_melody(ble_connected_melody, ARRAY_SIZE(ble_connected_melody));
-    LOG_INF("BLE connected sound played");
+// Consumer side: runs as a feedback job and starts at most one melody, highest
+// priority first. Lower priority requests wait for the current melody to end and
+// are dropped once they are older than SOUND_REQ_MAX_AGE_MS.
+static void sound_request_work(struct feedback_job *job) {
+    uint8_t cls, arg;
+
+    // A melody in progress is only preempted by a request of its own class or above
+    while (sound_mailbox_take(&sound_requests,
+                              buzzer_state.is_playing ? buzzer_state.seq.sound_class : 0,
+                              k_uptime_get_32(), &cls, &arg)) {
+        play_sound_request(cls, arg);
+        if (buzzer_state.is_playing) {
+            break;
+        }
+    }
+
+    LOG_DBG("Sound requests: %d posted, %d coalesced, %d dropped",
+            (int)atomic_get(&sound_requests.posted), (int)atomic_get(&sound_requests.coalesced),
+            (int)atomic_get(&sound_requests.dropped));
 }
 
-// Anti-spam protected public interface functions
+// Public interface, each sound class limited by its own token bucket
 static inline void play_profile_sound(uint8_t profile_idx) {
-    uint32_t now = k_uptime_get_32();
-
-    if (profile_idx >= 5 || !buzzer_state.hw_ready) {
+    if (profile_idx >= MAX_BLE_PROFILES || !buzzer_state.hw_ready) {
         return;
     }
 
-    // Check for profile spam
-    if (is_spam_detected(now, buzzer_state.last_profile_change, MIN_PROFILE_INTERVAL_MS)) {
-        LOG_WRN("Profile change spam detected");
-        return;
-    }
-
-    if (should_block_sound(now, buzzer_state.last_profile_change, MIN_PROFILE_INTERVAL_MS)) {
-        LOG_DBG("Profile sound blocked - too frequent");
-        return;
+    if (sound_rate_ok(SOUND_CLASS_PROFILE)) {
+        sound_request_post(SOUND_CLASS_PROFILE, profile_idx);
     }
-
-    buzzer_state.last_profile_change = now;
-    pending_profile = profile_idx;
-    k_work_submit_to_queue(&buzzer_state.work_queue, &profile_work);
 }
 
 static inline void play_startup_sound(void) {
-    if (buzzer_state.hw_ready) {
-        pending_system_sound = 1;
-        k_work_submit_to_queue(&buzzer_state.work_queue, &system_work);
+    if (buzzer_state.hw_ready && sound_rate_ok(SOUND_CLASS_STARTUP)) {
+        sound_request_post(SOUND_CLASS_STARTUP, 0);
     }
 }
 
-static inline void play_usb_sound(void) {
-    uint32_t now = k_uptime_get_32();
-
-    if (!buzzer_state.hw_ready) {
-        return;
+static inline void play_endpoint_sound(enum endpoint_sound sound) {
+    if (buzzer_state.hw_ready && sound_rate_ok(SOUND_CLASS_ENDPOINT)) {
+        sound_request_post(SOUND_CLASS_ENDPOINT, sound);
     }
+}
 
-    if (should_block_sound(now, buzzer_state.last_endpoint_change, MIN_ENDPOINT_INTERVAL_MS)) {
-        LOG_DBG("USB sound blocked - too frequent");
-        return;
+static inline void play_ble_connected_sound(void) {
+    if (buzzer_state.hw_ready && sound_rate_ok(SOUND_CLASS_CONNECTION)) {
+        sound_request_post(SOUND_CLASS_CONNECTION, 0);
     }
-
-    buzzer_state.last_endpoint_change = now;
-    pending_system_sound = 2;
-    k_work_submit_to_queue(&buzzer_state.work_queue, &system_work);
 }
 
-static inline void play_ble_sound(void) {
-    uint32_t now = k_uptime_get_32();
-
-    if (!buzzer_state.hw_ready) {
-        return;
+// Endpoint, profile and connection sounds all come from the shared connection state,
+// which only raises its event when something actually changed
+static int conn_state_listener(const zmk_event_t *eh) {
+    const struct deemen17_conn_state_changed *ev = as_deemen17_conn_state_changed(eh);
+    const struct conn_state *state = &ev->state;
+
+    if (ev->changes & CONN_STATE_CHANGED_ENDPOINT) {
+        if (state->endpoint.transport == ZMK_TRANSPORT_USB) {
+            play_endpoint_sound(ENDPOINT_SOUND_USB);
+            LOG_DBG("Endpoint: USB");
+        } else if (state->endpoint.transport == ZMK_TRANSPORT_BLE) {
+            play_endpoint_sound(ENDPOINT_SOUND_BLE);
+            LOG_DBG("Endpoint: BLE");
+        }
     }
 
-    if (should_block_sound(now, buzzer_state.last_endpoint_change, MIN_ENDPOINT_INTERVAL_MS)) {
-        LOG_DBG("BLE sound blocked - too frequent");
-        return;
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    if (ev->changes & CONN_STATE_CHANGED_PROFILE) {
+        play_profile_sound(state->active_profile);
+        LOG_DBG("Profile changed to %d", state->active_profile);
+    } else if ((ev->changes & CONN_STATE_CHANGED_CONNECTED) && state->active_profile_connected &&
+               state->active_profile < MAX_BLE_PROFILES) {
+        play_ble_connected_sound();
+        LOG_INF("BLE profile %d connected", state->active_profile);
     }
+#endif
 
-    buzzer_state.last_endpoint_change = now;
-    pending_system_sound = 3;
-    k_work_submit_to_queue(&buzzer_state.work_queue, &system_work);
+    return ZMK_EV_EVENT_BUBBLE;
 }
 
-static inline void play_ble_connected_sound(void) {
-    uint32_t now = k_uptime_get_32();
+#if IS_ENABLED(CONFIG_DEEMEN17_BUZZER_CLICK) && BUZZER_PWM_SEQ
+// Key click: one short burst, armed at build time and started straight from the
+// key event. The PWM peripheral stops it by itself, so nothing else runs per click.
+#define CLICK_PERIOD_NS 250000 // 4 kHz
+#define CLICK_PERIODS 8        // 2 ms
 
-    if (!buzzer_state.hw_ready) {
-        return;
-    }
+BUILD_ASSERT(CLICK_PERIODS % SEQ_BLOCK_PERIODS == 0, "The click must be whole blocks");
 
-    // Connection sounds are less restricted but still have basic protection
-    if (should_block_sound(now, buzzer_state.last_sound_played, MIN_SOUND_INTERVAL_MS)) {
-        LOG_DBG("BLE connected sound blocked - too frequent");
-        return;
-    }
+static const struct pwm_seq_step click_steps[] = {
+    {.period_ns = CLICK_PERIOD_NS, .pulse_ns = CLICK_PERIOD_NS / 2U, .periods = CLICK_PERIODS},
+};
+
+static struct {
+    uint32_t last_click;
+    bool battery_low;
+    uint32_t clicks;
+    uint32_t rate_limited;
+} click_state;
 
-    k_work_submit_to_queue(&buzzer_state.work_queue, &connection_work);
+// PWM interrupt at the end of the burst
+static void click_done(const struct device *dev, void *user_data) {
+    energy_source_set(ENERGY_SOURCE_BUZZER, false);
 }
 
-// Optimized event listeners
-static int buzzer_listener(const zmk_event_t *eh) {
-    const struct zmk_ble_active_profile_changed *profile_ev = as_zmk_ble_active_profile_changed(eh);
-    if (!profile_ev) {
-        return ZMK_EV_EVENT_BUBBLE;
+static bool click_allowed(void) {
+#if IS_ENABLED(CONFIG_ZMK_USB)
+    if (zmk_usb_is_powered()) {
+        return true;
     }
+#endif
+    return !click_state.battery_low;
+}
 
-    uint8_t profile_index = profile_ev->index;
-    if (profile_index < MAX_BLE_PROFILES) {
-        buzzer_state.current_profile = profile_index;
-        play_profile_sound(profile_index);
-        LOG_DBG("Profile changed to %d", profile_index);
-    }
+static int click_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+    uint32_t now = k_uptime_get_32();
 
-    return ZMK_EV_EVENT_BUBBLE;
-}
+    // Melodies take precedence, and own the PWM until they have silenced it
+    if (!ev->state || !buzzer_state.hw_ready || buzzer_state.is_playing || !click_allowed()) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
 
-static int endpoint_listener(const zmk_event_t *eh) {
-    const struct zmk_endpoint_changed *endpoint_ev = as_zmk_endpoint_changed(eh);
-    if (!endpoint_ev) {
+    if (click_state.clicks > 0 &&
+        now - click_state.last_click < CONFIG_DEEMEN17_BUZZER_CLICK_MIN_INTERVAL_MS) {
+        click_state.rate_limited++;
         return ZMK_EV_EVENT_BUBBLE;
     }
 
-    // Check endpoint type using transport field
-    if (endpoint_ev->endpoint.transport == ZMK_TRANSPORT_USB) {
-        play_usb_sound();
-        LOG_DBG("Endpoint: USB");
-    } else if (endpoint_ev->endpoint.transport == ZMK_TRANSPORT_BLE) {
-        play_ble_sound();
-        LOG_DBG("Endpoint: BLE");
+    if (pwm_seq_play(pwm.dev, pwm.channel, pwm.flags, click_steps, ARRAY_SIZE(click_steps),
+                     click_done, NULL) == 0) {
+        energy_source_set(ENERGY_SOURCE_BUZZER, true);
+        click_state.last_click = now;
+        click_state.clicks++;
     }
 
     return ZMK_EV_EVENT_BUBBLE;
 }
 
-// Optimized BLE connection monitoring
-static void ble_connection_monitor(struct k_work *work) {
-    bool state_changed = false;
-
-    // Check only the active profile for connection state
-    uint8_t active_profile = zmk_ble_active_profile_index();
-    bool current_state = zmk_ble_active_profile_is_connected();
+// Listeners run in name order: "keypress_click" sorts after ZMK's "keymap", so the
+// HID report for the press has already been sent when the click starts
+DEEMEN17_LISTENER(keypress_click, click_listener);
+ZMK_SUBSCRIPTION(keypress_click, zmk_position_state_changed);
 
-    // Update current profile tracking
-    buzzer_state.current_profile = active_profile;
+#if IS_ENABLED(CONFIG_ZMK_BATTERY_REPORTING)
+static int click_battery_listener(const zmk_event_t *eh) {
+    const struct zmk_battery_state_changed *ev = as_zmk_battery_state_changed(eh);
 
-    // Check for new connection on active profile
-    if (current_state && !buzzer_state.connection_states[active_profile]) {
-        play_ble_connected_sound();
-        LOG_INF("BLE profile %d connected", active_profile);
-        state_changed = true;
-    }
-
-    // Update connection state for active profile
-    buzzer_state.connection_states[active_profile] = current_state;
-
-    if (state_changed) {
-        LOG_DBG("BLE connection states updated");
-    }
+    click_state.battery_low = ev->state_of_charge < CONFIG_DEEMEN17_BUZZER_CLICK_MIN_BATTERY;
+    return ZMK_EV_EVENT_BUBBLE;
 }
 
-K_WORK_DEFINE(ble_monitor_work, ble_connection_monitor);
+DEEMEN17_LISTENER(buzzer_click_battery, click_battery_listener);
+ZMK_SUBSCRIPTION(buzzer_click_battery, zmk_battery_state_changed);
+#endif
+#endif
 
-static void ble_monitor_timer_handler(struct k_timer *timer) {
-    k_work_submit_to_queue(&buzzer_state.work_queue, &ble_monitor_work);
+static void startup_chime(struct feedback_job *job) {
+    boot_profile_mark(BOOT_STAGE_STARTUP_CHIME);
+    play_startup_sound();
 }
 
-K_TIMER_DEFINE(ble_monitor_timer, ble_monitor_timer_handler, NULL);
+static FEEDBACK_JOB_DEFINE(startup_job, startup_chime);
 
-// Optimized buzzer initialization
+// Optimized buzzer initialization, never waits
 static int buzzer_init(void) {
     // Hardware check
     if (!device_is_ready(pwm.dev)) {
@@ -386,49 +571,24 @@ static int buzzer_init(void) {
     }
 
     buzzer_state.hw_ready = true;
+    feedback_job_init(&buzzer_state.seq_job, buzzer_seq_step);
 
-    // Initialize work queue with dedicated thread
-    k_work_queue_init(&buzzer_state.work_queue);
-    k_work_queue_start(&buzzer_state.work_queue, buzzer_state.work_stack,
-                       K_THREAD_STACK_SIZEOF(buzzer_state.work_stack), BUZZER_THREAD_PRIORITY,
-                       NULL);
-
-    // Initialize BLE connection state tracking
-    buzzer_state.current_profile = zmk_ble_active_profile_index();
-
-    // Initialize connection states - only track active profile
-    for (int i = 0; i < MAX_BLE_PROFILES; i++) {
-        buzzer_state.connection_states[i] = false; // Initialize to false
+    // Start with full buckets so the first events after boot are not dropped
+    for (int i = 0; i < SOUND_CLASS_COUNT; i++) {
+        sound_bucket_init(&sound_buckets[i], &sound_limits[i], k_uptime_get_32());
     }
 
-    // Set current active profile connection state
-    buzzer_state.connection_states[buzzer_state.current_profile] =
-        zmk_ble_active_profile_is_connected();
+    // The chime is deferred so the rest of APPLICATION init, the first matrix scan and
+    // advertising are not held up behind it; after soft-off it waits for the first report
+    fast_resume_defer(&startup_job, STARTUP_CHIME_DELAY_MS, SOUND_REQ_SLACK_MS);
+    boot_profile_mark(BOOT_STAGE_BUZZER_READY);
 
-    // Delay for system stability
-    k_msleep(300);
-
-    // Play startup sound
-    play_startup_sound();
-
-    // Start BLE monitoring with optimized interval
-    k_timer_start(&ble_monitor_timer, K_MSEC(BLE_MONITOR_INTERVAL_MS),
-                  K_MSEC(BLE_MONITOR_INTERVAL_MS));
-
-    LOG_INF("Buzzer system initialized (thread priority: %d)", BUZZER_THREAD_PRIORITY);
+    LOG_INF("Buzzer system initialized");
     return 0;
 }
 
-ZMK_LISTENER(buzzer_output_status, buzzer_listener)
-ZMK_LISTENER(buzzer_endpoint_status, endpoint_listener)
-
-#if defined(CONFIG_ZMK_BLE)
-ZMK_SUBSCRIPTION(buzzer_output_status, zmk_ble_active_profile_changed);
-#endif
-
-#if defined(CONFIG_ZMK_USB) || defined(CONFIG_ZMK_BLE)
-ZMK_SUBSCRIPTION(buzzer_endpoint_status, zmk_endpoint_changed);
-#endif
+DEEMEN17_LISTENER(buzzer_conn_status, conn_state_listener);
+ZMK_SUBSCRIPTION(buzzer_conn_status, deemen17_conn_state_changed);
 
 // Initialize buzzer after system startup
 SYS_INIT(buzzer_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -1,3 +1,5 @@
+#include <string.h>
+
 #include <zephyr/device.h>
 #include <zephyr/devicetree.h>
 #include <zephyr/drivers/led.h>
@@ -8,11 +10,6 @@
 #include <zmk/usb.h>
 #include <zmk/ble.h>
 #include <zmk/endpoints.h>
-#include <zmk/hid_indicators.h>
-
-#include <zmk/events/ble_active_profile_changed.h>
-#include <zmk/events/endpoint_changed.h>
-#include <zmk/events/hid_indicators_changed.h>
 
 #include <zmk/events/battery_state_changed.h>
 #include <zmk/events/layer_state_changed.h>
@@ -21,6 +18,11 @@
 #include <zmk/keymap.h>
 #include <zmk/split/bluetooth/peripheral.h>
 
+#include <deemen17/conn_state.h>
+#include <deemen17/energy.h>
+#include <deemen17/feedback.h>
+#include <deemen17/listener_profile.h>
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 
@@ -29,137 +31,148 @@ LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
 // GPIO-based LED device
 static const struct device *led_dev = DEVICE_DT_GET(LED_GPIO_NODE_ID);
 
-// 
-struct output_status_state {
-    struct zmk_endpoint_instance selected_endpoint;
-    bool active_profile_connected;
-    bool active_profile_bonded;
+// LED updates only need to land within this time
+#define LED_UPDATE_SLACK_MS 20
+
+// Every blink half-period is a multiple of the shared tick
+#define BLINK_TICK_MS 250
+#define BLINK_FAST_MS 500  // Open profile, advertising for a new host
+#define BLINK_SLOW_MS 1000 // Bonded profile waiting for its host to reconnect
+
+enum status_led {
+    STATUS_LED_USB,
+    STATUS_LED_BLE_0,
+    STATUS_LED_BLE_1,
+    STATUS_LED_BLE_2,
+    STATUS_LED_COUNT,
 };
 
-// 
-static struct output_status_state get_state(const zmk_event_t *_eh) {
-    return (struct output_status_state){
-        .selected_endpoint = zmk_endpoints_selected(),
-        .active_profile_connected = zmk_ble_active_profile_is_connected(),
-        .active_profile_bonded = !zmk_ble_active_profile_is_open(),
-    };
-}
+static const uint32_t status_led_index[STATUS_LED_COUNT] = {
+    DT_NODE_CHILD_IDX(DT_ALIAS(led_usb)),
+    DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_0)),
+    DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_1)),
+    DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_2)),
+};
 
-// Timer và trạng thái cho LED BLE quảng bá
-static struct k_timer ble_adv_timer;
-static bool ble_adv_led_on = false;
-static int ble_adv_led_index = -1;
+// Desired pattern per LED: off, solid, or blinking with this half-period
+struct led_pattern {
+    bool on;
+    uint16_t blink_ms; // 0 for solid
+};
 
-// Hàm callback của timer để nháy LED
-static void ble_adv_timer_handler(struct k_timer *timer_id) {
-    if (ble_adv_led_index >= 0) {
-        if (ble_adv_led_on) {
-            led_off(led_dev, ble_adv_led_index);
-        } else {
-            led_on(led_dev, ble_adv_led_index);
+static struct conn_state snapshot; // Generation 0 until the first update
+static struct led_pattern patterns[STATUS_LED_COUNT];
+static uint8_t lit;          // LEDs currently on, one bit per status_led
+static uint32_t blink_ticks; // Ticks since blinking started
+
+static void ble_blink_tick(struct feedback_job *job);
+static FEEDBACK_JOB_DEFINE(blink_job, ble_blink_tick);
+
+static void compute_patterns(const struct conn_state *state) {
+    memset(patterns, 0, sizeof(patterns));
+
+    switch (state->endpoint.transport) {
+    case ZMK_TRANSPORT_USB:
+        patterns[STATUS_LED_USB].on = true;
+        break;
+    case ZMK_TRANSPORT_BLE: {
+        uint8_t profile = state->endpoint.ble.profile_index;
+
+        if (profile >= STATUS_LED_COUNT - STATUS_LED_BLE_0) {
+            break;
+        }
+
+        struct led_pattern *pattern = &patterns[STATUS_LED_BLE_0 + profile];
+
+        pattern->on = true;
+        if (!state->active_profile_bonded) {
+            pattern->blink_ms = BLINK_FAST_MS;
+        } else if (!state->active_profile_connected) {
+            pattern->blink_ms = BLINK_SLOW_MS;
         }
-        ble_adv_led_on = !ble_adv_led_on; // Đảo trạng thái LED
+        break;
+    }
     }
 }
 
+// Drive only the LEDs whose level differs from what they show now; returns
+// whether any LED is blinking
+static bool apply_patterns(void) {
+    uint8_t want = 0;
+    bool blinking = false;
+
+    for (int i = 0; i < STATUS_LED_COUNT; i++) {
+        const struct led_pattern *pattern = &patterns[i];
+        bool on = pattern->on;
 
+        if (on && pattern->blink_ms) {
+            blinking = true;
+            on = (blink_ticks / (pattern->blink_ms / BLINK_TICK_MS)) % 2 == 0;
+        }
+        WRITE_BIT(want, i, on);
+    }
 
-// Caps Lock Indicator
-static int led_keylock_listener_cb(const zmk_event_t *eh) {
-    zmk_hid_indicators_t flags = zmk_hid_indicators_get_current_profile();
-    unsigned int capsBit = 1 << (HID_USAGE_LED_CAPS_LOCK - 1);
+    for (uint8_t changed = want ^ lit; changed; changed &= changed - 1) {
+        int i = __builtin_ctz(changed);
 
-    if (flags & capsBit) {
-        led_on(led_dev, DT_NODE_CHILD_IDX(DT_ALIAS(led_caps)));
-    } else {
-        led_off(led_dev, DT_NODE_CHILD_IDX(DT_ALIAS(led_caps)));
+        if (want & BIT(i)) {
+            led_on(led_dev, status_led_index[i]);
+        } else {
+            led_off(led_dev, status_led_index[i]);
+        }
+        energy_led_set(led_dev, status_led_index[i], want & BIT(i));
     }
+    lit = want;
 
-    return 0;
+    return blinking;
 }
 
-// Output Selection Indicators
+// Shared blink tick, only scheduled while some LED is blinking
+static void ble_blink_tick(struct feedback_job *job) {
+    blink_ticks++;
+    if (apply_patterns()) {
+        feedback_job_schedule(job, BLINK_TICK_MS, LED_UPDATE_SLACK_MS);
+    }
+}
 
-static void set_status_led(struct output_status_state state) {
-    // Tắt tất cả các LED trước khi bật LED tương ứng
-    led_off(led_dev, DT_NODE_CHILD_IDX(DT_ALIAS(led_usb)));
-    led_off(led_dev, DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_0)));
-    led_off(led_dev, DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_1)));
-    led_off(led_dev, DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_2)));
+static void output_status_update(struct feedback_job *job) {
+    struct conn_state state;
 
-    switch (state.selected_endpoint.transport) {
-    case ZMK_TRANSPORT_USB:
-        // Bật LED USB
-        led_on(led_dev, DT_NODE_CHILD_IDX(DT_ALIAS(led_usb)));
-        break;
-    case ZMK_TRANSPORT_BLE:
-        if (state.active_profile_bonded) {
-            if (state.active_profile_connected) {
-                // Bật LED BLE đã kết nối
-                switch (state.selected_endpoint.ble.profile_index) {
-                case 0:
-                    led_on(led_dev, DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_0)));
-                    break;
-                case 1:
-                    led_on(led_dev, DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_1)));
-                    break;
-                case 2:
-                    led_on(led_dev, DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_2)));
-                    break;
-                }
-            } else {
-                // BLE chưa kết nối - có thể để trống hoặc thêm logic
-            }
-        } else {
-            switch (state.selected_endpoint.ble.profile_index) {
-            case 0:
-                ble_adv_led_index = DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_0));
-                break;
-            case 1:
-                ble_adv_led_index = DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_1));
-                break;
-            case 2:
-                ble_adv_led_index = DT_NODE_CHILD_IDX(DT_ALIAS(led_ble_2));
-                break;
-            }
-
-            // Khởi động timer để nháy LED
-            if (ble_adv_led_index >= 0) {
-                k_timer_start(&ble_adv_timer, K_MSEC(500), K_MSEC(500)); // 500ms nháy
-            }
-        }
-        break;
+    conn_state_get(&state);
+    if (state.generation == snapshot.generation) {
+        return;
+    }
+    snapshot = state;
+    compute_patterns(&snapshot);
+
+    // A new pattern starts its blink from the lit phase
+    blink_ticks = 0;
+    if (apply_patterns()) {
+        feedback_job_schedule(&blink_job, BLINK_TICK_MS, LED_UPDATE_SLACK_MS);
+    } else {
+        feedback_job_cancel(&blink_job);
     }
 }
 
+static FEEDBACK_JOB_DEFINE(output_status_job, output_status_update);
+
 static int output_status_update_cb(const zmk_event_t *_eh) {
-    struct output_status_state state = get_state(_eh);
-    set_status_led(state);
+    feedback_job_schedule(&output_status_job, 0, LED_UPDATE_SLACK_MS);
 
     return 0;
 }
 
-ZMK_LISTENER(led_indicators_listener, led_keylock_listener_cb);
-ZMK_SUBSCRIPTION(led_indicators_listener, zmk_hid_indicators_changed);
-
-
-ZMK_LISTENER(output_status, output_status_update_cb);
-#if defined(CONFIG_ZMK_BLE)
-ZMK_SUBSCRIPTION(output_status, zmk_ble_active_profile_changed);
-#endif
-ZMK_SUBSCRIPTION(output_status, zmk_endpoint_changed);
+DEEMEN17_LISTENER(output_status, output_status_update_cb);
+ZMK_SUBSCRIPTION(output_status, deemen17_conn_state_changed);
 
 static int leds_init(const struct device *device) {
     if (!device_is_ready(led_dev)) {
         return -ENODEV;
     }
 
-    return 0;
-}
+    // Show the state the keyboard boots into without waiting for the first event
+    feedback_job_schedule(&output_status_job, 0, LED_UPDATE_SLACK_MS);
 
-int output_status_init(void) {
-    // Khởi tạo timer nháy LED
-    k_timer_init(&ble_adv_timer, ble_adv_timer_handler, NULL);
     return 0;
 }
 
@@ -0,0 +1,545 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_kscan_port_matrix
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/kscan.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/pm/device.h>
+
+#if IS_ENABLED(CONFIG_DEEMEN17_KSCAN_PORT_MATRIX_STATS)
+#include <zephyr/timing/timing.h>
+#endif
+
+#include <deemen17/boot_profile.h>
+
+LOG_MODULE_REGISTER(kscan_port_matrix, CONFIG_KSCAN_LOG_LEVEL);
+
+// Sense lines may be spread over at most this many GPIO ports
+#define PORT_MATRIX_MAX_PORTS 2
+
+// diode-direction is an enum of "row2col", "col2row"
+#define INST_COL2ROW(n) (DT_INST_ENUM_IDX(n, diode_direction) == 1)
+#define INST_ROWS(n) DT_INST_PROP_LEN(n, row_gpios)
+#define INST_COLS(n) DT_INST_PROP_LEN(n, col_gpios)
+
+// Release window grows by doubling, up to this many steps, on keys that chatter
+#define CHATTER_LEVEL_MAX 3
+#define CHATTER_LEVEL_BITS 2
+#define CHATTER_LEVELS_PER_BYTE (8 / CHATTER_LEVEL_BITS)
+
+struct port_matrix_port {
+    const struct device *dev; // kscan device, for the interrupt callback
+    const struct device *port;
+    gpio_port_pins_t mask;        // Sense pins on this port
+    gpio_port_value_t active_low; // Sense pins that read inverted
+    struct gpio_callback irq_cb;
+};
+
+struct port_matrix_config {
+    const struct gpio_dt_spec *rows;
+    const struct gpio_dt_spec *cols;
+    uint8_t rows_len;
+    uint8_t cols_len;
+    bool col2row;
+    bool eager_press;
+    uint8_t debounce_press_ms;
+    uint8_t debounce_release_ms;
+    uint8_t debounce_release_max_ms;
+    uint8_t scan_period_ms;
+    uint16_t wait_before_inputs_us;
+    uint16_t wait_between_outputs_us;
+};
+
+struct port_matrix_data {
+    const struct device *dev;
+    kscan_callback_t callback;
+    struct k_work_delayable work;
+    bool enabled;
+
+    struct port_matrix_port ports[PORT_MATRIX_MAX_PORTS];
+    uint8_t ports_len;
+    uint8_t *input_port; // Port index of each sense line
+
+    // Per strobe line: one bit per sense line
+    uint32_t *state;    // Debounced key state
+    uint32_t *counting; // Keys whose raw state differs and are being debounced
+    uint32_t *bounced;  // Steady keys that bounced since their last reported press
+    uint32_t *steady;   // Held keys stable for the base release window since their press
+    uint8_t *counters;  // Debounce time, or stable time of a held key, per key in ms
+    uint8_t *chatter;   // Per key release window level, packed CHATTER_LEVEL_BITS each
+
+#if IS_ENABLED(CONFIG_DEEMEN17_KSCAN_PORT_MATRIX_STATS)
+    uint32_t scans;
+    uint64_t scan_cycles_total;
+    uint64_t scan_cycles_max;
+#endif
+};
+
+static inline const struct gpio_dt_spec *strobes(const struct port_matrix_config *config) {
+    return config->col2row ? config->cols : config->rows;
+}
+
+static inline const struct gpio_dt_spec *senses(const struct port_matrix_config *config) {
+    return config->col2row ? config->rows : config->cols;
+}
+
+static inline uint8_t strobes_len(const struct port_matrix_config *config) {
+    return config->col2row ? config->cols_len : config->rows_len;
+}
+
+static inline uint8_t senses_len(const struct port_matrix_config *config) {
+    return config->col2row ? config->rows_len : config->cols_len;
+}
+
+static void port_matrix_set_all_strobes(const struct device *dev, int value) {
+    const struct port_matrix_config *config = dev->config;
+
+    for (int s = 0; s < strobes_len(config); s++) {
+        gpio_pin_set_dt(&strobes(config)[s], value);
+    }
+}
+
+static void port_matrix_set_interrupts(const struct device *dev, gpio_flags_t flags) {
+    const struct port_matrix_config *config = dev->config;
+
+    for (int i = 0; i < senses_len(config); i++) {
+        gpio_pin_interrupt_configure_dt(&senses(config)[i], flags);
+    }
+}
+
+// Idle: drive every strobe and wait for any sense line to go active
+static void port_matrix_arm(const struct device *dev) {
+    port_matrix_set_all_strobes(dev, 1);
+    port_matrix_set_interrupts(dev, GPIO_INT_LEVEL_ACTIVE);
+}
+
+static void port_matrix_disarm(const struct device *dev) {
+    port_matrix_set_interrupts(dev, GPIO_INT_DISABLE);
+    port_matrix_set_all_strobes(dev, 0);
+}
+
+static void port_matrix_irq(const struct device *port, struct gpio_callback *cb,
+                            gpio_port_pins_t pins) {
+    struct port_matrix_port *p = CONTAINER_OF(cb, struct port_matrix_port, irq_cb);
+    struct port_matrix_data *data = p->dev->data;
+
+    port_matrix_disarm(p->dev);
+    k_work_reschedule(&data->work, K_NO_WAIT);
+}
+
+// Sample all sense lines for the active strobe: one IN register read per port
+static uint32_t port_matrix_read_senses(const struct device *dev) {
+    const struct port_matrix_config *config = dev->config;
+    struct port_matrix_data *data = dev->data;
+    gpio_port_value_t values[PORT_MATRIX_MAX_PORTS];
+    uint32_t bits = 0;
+
+    for (int p = 0; p < data->ports_len; p++) {
+        gpio_port_get_raw(data->ports[p].port, &values[p]);
+        values[p] ^= data->ports[p].active_low;
+    }
+
+    for (int i = 0; i < senses_len(config); i++) {
+        bits |= ((values[data->input_port[i]] >> senses(config)[i].pin) & 1U) << i;
+    }
+
+    return bits;
+}
+
+static void port_matrix_report(const struct device *dev, int strobe, int sense, bool pressed) {
+    const struct port_matrix_config *config = dev->config;
+    struct port_matrix_data *data = dev->data;
+    uint32_t row = config->col2row ? sense : strobe;
+    uint32_t col = config->col2row ? strobe : sense;
+
+    LOG_DBG("Sending event at %d,%d state %s", row, col, pressed ? "on" : "off");
+    data->callback(dev, row, col, pressed);
+}
+
+static inline uint8_t chatter_get(const struct port_matrix_data *data, int key) {
+    uint8_t shift = (key % CHATTER_LEVELS_PER_BYTE) * CHATTER_LEVEL_BITS;
+
+    return (data->chatter[key / CHATTER_LEVELS_PER_BYTE] >> shift) & BIT_MASK(CHATTER_LEVEL_BITS);
+}
+
+static inline void chatter_set(struct port_matrix_data *data, int key, uint8_t level) {
+    uint8_t shift = (key % CHATTER_LEVELS_PER_BYTE) * CHATTER_LEVEL_BITS;
+    uint8_t *byte = &data->chatter[key / CHATTER_LEVELS_PER_BYTE];
+
+    *byte = (*byte & ~(BIT_MASK(CHATTER_LEVEL_BITS) << shift)) | (level << shift);
+}
+
+// Release window of a key: the base window, doubled for every chatter level
+static uint8_t port_matrix_release_window(const struct device *dev, int key) {
+    const struct port_matrix_config *config = dev->config;
+    uint32_t window = (uint32_t)config->debounce_release_ms << chatter_get(dev->data, key);
+
+    return MIN(window, MAX(config->debounce_release_ms, config->debounce_release_max_ms));
+}
+
+// A key that bounced while held widens its release window, a clean one narrows it
+static void port_matrix_adapt(const struct device *dev, int key, bool bounced) {
+    const struct port_matrix_config *config = dev->config;
+    struct port_matrix_data *data = dev->data;
+    uint8_t level = chatter_get(data, key);
+
+    if (config->debounce_release_max_ms <= config->debounce_release_ms) {
+        return;
+    }
+
+    if (bounced && level < CHATTER_LEVEL_MAX) {
+        chatter_set(data, key, level + 1);
+    } else if (!bounced && level > 0) {
+        chatter_set(data, key, level - 1);
+    }
+}
+
+// Debounce one strobe line; returns true if it still needs scanning
+static bool port_matrix_debounce(const struct device *dev, int s, uint32_t raw) {
+    const struct port_matrix_config *config = dev->config;
+    struct port_matrix_data *data = dev->data;
+    int first_key = s * senses_len(config);
+    uint8_t *counters = &data->counters[first_key];
+    uint32_t delta = raw ^ data->state[s];
+    uint32_t settled = data->counting[s] & ~delta;
+
+    // Keys that bounced back to their debounced level start over. Only bounces of
+    // steady keys count: contacts still settling from the press are not chatter.
+    data->bounced[s] |= settled & data->steady[s];
+    while (settled) {
+        int i = __builtin_ctz(settled);
+
+        settled &= settled - 1;
+        counters[i] = 0;
+    }
+    data->counting[s] &= delta;
+
+    // Held keys become steady once stable for the base release window
+    uint32_t settling = data->state[s] & ~delta & ~data->steady[s];
+    while (settling) {
+        int i = __builtin_ctz(settling);
+
+        settling &= settling - 1;
+        counters[i] = MIN(counters[i] + config->scan_period_ms, UINT8_MAX);
+        if (counters[i] >= config->debounce_release_ms) {
+            counters[i] = 0;
+            data->steady[s] |= BIT(i);
+        }
+    }
+
+    while (delta) {
+        int i = __builtin_ctz(delta);
+        bool pressed = raw & BIT(i);
+
+        delta &= delta - 1;
+
+        if (!(data->counting[s] & BIT(i))) {
+            // Starts debouncing, from zero even if the key was still settling
+            counters[i] = 0;
+        }
+
+        // With eager press the first active sample is reported, only releases wait
+        if (!(pressed && config->eager_press)) {
+            uint8_t threshold = pressed ? config->debounce_press_ms
+                                        : port_matrix_release_window(dev, first_key + i);
+
+            counters[i] = MIN(counters[i] + config->scan_period_ms, UINT8_MAX);
+            if (counters[i] < threshold) {
+                data->counting[s] |= BIT(i);
+                continue;
+            }
+        }
+
+        counters[i] = 0;
+        data->counting[s] &= ~BIT(i);
+        WRITE_BIT(data->state[s], i, pressed);
+        if (!pressed) {
+            port_matrix_adapt(dev, first_key + i, data->bounced[s] & BIT(i));
+        }
+        data->bounced[s] &= ~BIT(i);
+        data->steady[s] &= ~BIT(i);
+        port_matrix_report(dev, s, i, pressed);
+    }
+
+    return data->state[s] || data->counting[s];
+}
+
+static void port_matrix_scan(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct port_matrix_data *data = CONTAINER_OF(dwork, struct port_matrix_data, work);
+    const struct device *dev = data->dev;
+    const struct port_matrix_config *config = dev->config;
+    bool active = false;
+
+    if (!data->enabled) {
+        return;
+    }
+
+    boot_profile_mark(BOOT_STAGE_FIRST_SCAN);
+
+#if IS_ENABLED(CONFIG_DEEMEN17_KSCAN_PORT_MATRIX_STATS)
+    timing_t start = timing_counter_get();
+#endif
+
+    for (int s = 0; s < strobes_len(config); s++) {
+        const struct gpio_dt_spec *strobe = &strobes(config)[s];
+        uint32_t raw;
+
+        gpio_pin_set_dt(strobe, 1);
+        if (config->wait_before_inputs_us) {
+            k_busy_wait(config->wait_before_inputs_us);
+        }
+        raw = port_matrix_read_senses(dev);
+        gpio_pin_set_dt(strobe, 0);
+        if (config->wait_between_outputs_us) {
+            k_busy_wait(config->wait_between_outputs_us);
+        }
+
+        // Nothing pressed, nothing changed and nothing debouncing on this line
+        if (!(raw | data->state[s] | data->counting[s])) {
+            continue;
+        }
+
+        active |= port_matrix_debounce(dev, s, raw);
+    }
+
+#if IS_ENABLED(CONFIG_DEEMEN17_KSCAN_PORT_MATRIX_STATS)
+    timing_t end = timing_counter_get();
+    uint64_t cycles = timing_cycles_get(&start, &end);
+
+    data->scans++;
+    data->scan_cycles_total += cycles;
+    data->scan_cycles_max = MAX(data->scan_cycles_max, cycles);
+    if (data->scans % CONFIG_DEEMEN17_KSCAN_PORT_MATRIX_STATS_INTERVAL == 0) {
+        LOG_INF("%u scans, full matrix scan mean %u ns max %u ns", data->scans,
+                (uint32_t)timing_cycles_to_ns_avg(data->scan_cycles_total, data->scans),
+                (uint32_t)timing_cycles_to_ns(data->scan_cycles_max));
+    }
+#endif
+
+    if (active) {
+        k_work_reschedule(&data->work, K_MSEC(config->scan_period_ms));
+    } else {
+        port_matrix_arm(dev);
+    }
+}
+
+static int port_matrix_configure(const struct device *dev, kscan_callback_t callback) {
+    struct port_matrix_data *data = dev->data;
+
+    if (!callback) {
+        return -EINVAL;
+    }
+
+    data->callback = callback;
+    return 0;
+}
+
+static int port_matrix_enable(const struct device *dev) {
+    struct port_matrix_data *data = dev->data;
+
+    data->enabled = true;
+    // Scan right away to pick up keys that are already held
+    port_matrix_disarm(dev);
+    k_work_reschedule(&data->work, K_NO_WAIT);
+    return 0;
+}
+
+static int port_matrix_disable(const struct device *dev) {
+    struct port_matrix_data *data = dev->data;
+
+    data->enabled = false;
+    k_work_cancel_delayable(&data->work);
+    port_matrix_disarm(dev);
+    return 0;
+}
+
+static int port_matrix_add_port(const struct device *dev, const struct gpio_dt_spec *spec) {
+    struct port_matrix_data *data = dev->data;
+    int p;
+
+    for (p = 0; p < data->ports_len; p++) {
+        if (data->ports[p].port == spec->port) {
+            break;
+        }
+    }
+
+    if (p == data->ports_len) {
+        if (p == PORT_MATRIX_MAX_PORTS) {
+            LOG_ERR("Sense lines span more than %d ports", PORT_MATRIX_MAX_PORTS);
+            return -ENOTSUP;
+        }
+        data->ports[p].dev = dev;
+        data->ports[p].port = spec->port;
+        data->ports_len++;
+    }
+
+    data->ports[p].mask |= BIT(spec->pin);
+    if (spec->dt_flags & GPIO_ACTIVE_LOW) {
+        data->ports[p].active_low |= BIT(spec->pin);
+    }
+
+    return p;
+}
+
+static int port_matrix_configure_pins(const struct device *dev) {
+    const struct port_matrix_config *config = dev->config;
+    int err;
+
+    for (int s = 0; s < strobes_len(config); s++) {
+        err = gpio_pin_configure_dt(&strobes(config)[s], GPIO_OUTPUT_INACTIVE);
+        if (err) {
+            LOG_ERR("Unable to configure strobe pin %d", s);
+            return err;
+        }
+    }
+
+    for (int i = 0; i < senses_len(config); i++) {
+        err = gpio_pin_configure_dt(&senses(config)[i], GPIO_INPUT);
+        if (err) {
+            LOG_ERR("Unable to configure sense pin %d", i);
+            return err;
+        }
+    }
+
+    return 0;
+}
+
+static int port_matrix_init(const struct device *dev) {
+    const struct port_matrix_config *config = dev->config;
+    struct port_matrix_data *data = dev->data;
+    int err;
+
+    data->dev = dev;
+
+    for (int i = 0; i < senses_len(config); i++) {
+        const struct gpio_dt_spec *spec = &senses(config)[i];
+
+        if (!gpio_is_ready_dt(spec)) {
+            LOG_ERR("GPIO port %s not ready", spec->port->name);
+            return -ENODEV;
+        }
+
+        err = port_matrix_add_port(dev, spec);
+        if (err < 0) {
+            return err;
+        }
+        data->input_port[i] = err;
+    }
+
+    err = port_matrix_configure_pins(dev);
+    if (err) {
+        return err;
+    }
+
+    for (int p = 0; p < data->ports_len; p++) {
+        gpio_init_callback(&data->ports[p].irq_cb, port_matrix_irq, data->ports[p].mask);
+        err = gpio_add_callback(data->ports[p].port, &data->ports[p].irq_cb);
+        if (err) {
+            LOG_ERR("Unable to add interrupt callback on %s", data->ports[p].port->name);
+            return err;
+        }
+    }
+
+    k_work_init_delayable(&data->work, port_matrix_scan);
+
+#if IS_ENABLED(CONFIG_DEEMEN17_KSCAN_PORT_MATRIX_STATS)
+    timing_init();
+    timing_start();
+#endif
+
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_PM_DEVICE)
+static int port_matrix_pm_action(const struct device *dev, enum pm_device_action action) {
+    const struct port_matrix_config *config = dev->config;
+    struct port_matrix_data *data = dev->data;
+
+    switch (action) {
+    case PM_DEVICE_ACTION_SUSPEND:
+        k_work_cancel_delayable(&data->work);
+        port_matrix_disarm(dev);
+        for (int s = 0; s < strobes_len(config); s++) {
+            gpio_pin_configure_dt(&strobes(config)[s], GPIO_DISCONNECTED);
+        }
+        for (int i = 0; i < senses_len(config); i++) {
+            gpio_pin_configure_dt(&senses(config)[i], GPIO_DISCONNECTED);
+        }
+        return 0;
+    case PM_DEVICE_ACTION_RESUME:
+        port_matrix_configure_pins(dev);
+        if (data->enabled) {
+            k_work_reschedule(&data->work, K_NO_WAIT);
+        }
+        return 0;
+    default:
+        return -ENOTSUP;
+    }
+}
+#endif
+
+static const struct kscan_driver_api port_matrix_api = {
+    .config = port_matrix_configure,
+    .enable_callback = port_matrix_enable,
+    .disable_callback = port_matrix_disable,
+};
+
+#define PORT_MATRIX_GPIO(node_id, prop, idx) GPIO_DT_SPEC_GET_BY_IDX(node_id, prop, idx)
+
+#define PORT_MATRIX_INST(n)                                                                        \
+    BUILD_ASSERT(INST_ROWS(n) <= 32 && INST_COLS(n) <= 32,                                         \
+                 "Rows and columns are tracked in 32 bit words");                                  \
+    BUILD_ASSERT(DT_INST_PROP(n, debounce_press_ms) <= UINT8_MAX &&                                \
+                     DT_INST_PROP(n, debounce_release_ms) <= UINT8_MAX &&                          \
+                     DT_INST_PROP(n, debounce_release_max_ms) <= UINT8_MAX,                        \
+                 "Debounce windows are counted in 8 bits");                                        \
+    static const struct gpio_dt_spec port_matrix_rows_##n[] = {                                    \
+        DT_FOREACH_PROP_ELEM_SEP(DT_DRV_INST(n), row_gpios, PORT_MATRIX_GPIO, (, ))};              \
+    static const struct gpio_dt_spec port_matrix_cols_##n[] = {                                    \
+        DT_FOREACH_PROP_ELEM_SEP(DT_DRV_INST(n), col_gpios, PORT_MATRIX_GPIO, (, ))};              \
+    static uint8_t port_matrix_input_port_##n[MAX(INST_ROWS(n), INST_COLS(n))];                    \
+    static uint32_t port_matrix_state_##n[MAX(INST_ROWS(n), INST_COLS(n))];                        \
+    static uint32_t port_matrix_counting_##n[MAX(INST_ROWS(n), INST_COLS(n))];                     \
+    static uint32_t port_matrix_bounced_##n[MAX(INST_ROWS(n), INST_COLS(n))];                      \
+    static uint32_t port_matrix_steady_##n[MAX(INST_ROWS(n), INST_COLS(n))];                       \
+    static uint8_t port_matrix_counters_##n[INST_ROWS(n) * INST_COLS(n)];                          \
+    static uint8_t port_matrix_chatter_##n[DIV_ROUND_UP(INST_ROWS(n) * INST_COLS(n),               \
+                                                        CHATTER_LEVELS_PER_BYTE)];                 \
+    static struct port_matrix_data port_matrix_data_##n = {                                        \
+        .input_port = port_matrix_input_port_##n,                                                  \
+        .state = port_matrix_state_##n,                                                            \
+        .counting = port_matrix_counting_##n,                                                      \
+        .bounced = port_matrix_bounced_##n,                                                        \
+        .steady = port_matrix_steady_##n,                                                          \
+        .counters = port_matrix_counters_##n,                                                      \
+        .chatter = port_matrix_chatter_##n,                                                        \
+    };                                                                                             \
+    static const struct port_matrix_config port_matrix_config_##n = {                              \
+        .rows = port_matrix_rows_##n,                                                              \
+        .cols = port_matrix_cols_##n,                                                              \
+        .rows_len = INST_ROWS(n),                                                                  \
+        .cols_len = INST_COLS(n),                                                                  \
+        .col2row = INST_COL2ROW(n),                                                                \
+        .eager_press = DT_INST_PROP(n, debounce_eager_press),                                      \
+        .debounce_press_ms = DT_INST_PROP(n, debounce_press_ms),                                   \
+        .debounce_release_ms = DT_INST_PROP(n, debounce_release_ms),                               \
+        .debounce_release_max_ms = DT_INST_PROP(n, debounce_release_max_ms),                       \
+        .scan_period_ms = DT_INST_PROP(n, debounce_scan_period_ms),                                \
+        .wait_before_inputs_us = DT_INST_PROP(n, wait_before_inputs_us),                           \
+        .wait_between_outputs_us = DT_INST_PROP(n, wait_between_outputs_us),                       \
+    };                                                                                             \
+    PM_DEVICE_DT_INST_DEFINE(n, port_matrix_pm_action);                                            \
+    DEVICE_DT_INST_DEFINE(n, port_matrix_init, PM_DEVICE_DT_INST_GET(n), &port_matrix_data_##n,    \
+                          &port_matrix_config_##n, POST_KERNEL, CONFIG_KSCAN_INIT_PRIORITY,        \
+                          &port_matrix_api);
+
+DT_INST_FOREACH_STATUS_OKAY(PORT_MATRIX_INST)
@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_led_strip_cache
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/led_strip.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_EXT_POWER)
+#include <drivers/ext_power.h>
+#endif
+
+LOG_MODULE_REGISTER(led_strip_cache, CONFIG_LED_STRIP_LOG_LEVEL);
+
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1,
+             "Exactly one deemen17,led-strip-cache node is supported");
+
+#define CHAIN_LENGTH DT_INST_PROP(0, chain_length)
+#define GAMMA_CORRECT DT_INST_PROP(0, gamma_correct)
+#define REFRESH_MS DT_INST_PROP(0, refresh_ms)
+
+BUILD_ASSERT(CHAIN_LENGTH == DT_PROP(DT_INST_PHANDLE(0, led_strip), chain_length),
+             "deemen17,led-strip-cache chain-length must match the chained strip");
+
+struct led_strip_cache_stats {
+    uint32_t frames;          // Frames handed in by the caller
+    uint32_t skipped;         // Frames identical to the last one sent
+    uint32_t transfers;       // Frames passed on to the strip
+    uint64_t filter_cycles;   // Gamma mapping and comparison
+    uint64_t transfer_cycles; // Chained driver, including the SPI transfer
+    uint32_t max_filter_cycles;
+    uint32_t max_transfer_cycles;
+    uint32_t since_ms; // Uptime the counters were cleared at
+};
+
+struct led_strip_cache_data {
+    // Last frame sent, and the frame being sent. The chained driver may overwrite the
+    // pixels it is given, so the comparison copy is never handed to it.
+    struct led_rgb last[CHAIN_LENGTH];
+    struct led_rgb tx[CHAIN_LENGTH];
+    size_t last_len;
+    bool valid;
+    bool powered; // Strip power when the last frame was sent
+    uint32_t last_tx_ms;
+    struct led_strip_cache_stats stats;
+};
+
+static const struct device *const strip = DEVICE_DT_GET(DT_INST_PHANDLE(0, led_strip));
+static struct led_strip_cache_data led_strip_cache_data;
+
+// &ext_power can cut the strip's supply without a frame from the underglow, and the
+// strip comes back dark. A change of power state counts as a changed frame.
+static bool strip_powered(void) {
+#if IS_ENABLED(CONFIG_ZMK_EXT_POWER) && DT_HAS_COMPAT_STATUS_OKAY(zmk_ext_power_generic)
+    return ext_power_get(DEVICE_DT_GET_ANY(zmk_ext_power_generic)) > 0;
+#else
+    return true;
+#endif
+}
+
+#if GAMMA_CORRECT
+// Square law, rounded up so every lit level stays lit
+static uint8_t gamma_table[256];
+
+static void gamma_table_init(void) {
+    for (int i = 0; i < ARRAY_SIZE(gamma_table); i++) {
+        gamma_table[i] = (i * i + 254) / 255;
+    }
+}
+
+static inline uint8_t gamma_map(uint8_t level) { return gamma_table[level]; }
+#else
+static inline uint8_t gamma_map(uint8_t level) { return level; }
+#endif
+
+static int led_strip_cache_update_rgb(const struct device *dev, struct led_rgb *pixels,
+                                      size_t num_pixels) {
+    struct led_strip_cache_data *data = dev->data;
+    size_t len = MIN(num_pixels, CHAIN_LENGTH);
+    bool powered = strip_powered();
+    bool changed = !data->valid || len != data->last_len || powered != data->powered;
+    uint32_t start = k_cycle_get_32();
+    uint32_t filter_cycles, transfer_cycles;
+    int err;
+
+    data->stats.frames++;
+
+    for (size_t i = 0; i < len; i++) {
+        struct led_rgb *px = &data->tx[i];
+        const struct led_rgb *last = &data->last[i];
+
+        px->r = gamma_map(pixels[i].r);
+        px->g = gamma_map(pixels[i].g);
+        px->b = gamma_map(pixels[i].b);
+        changed |= px->r != last->r || px->g != last->g || px->b != last->b;
+    }
+
+    if (!changed && REFRESH_MS && k_uptime_get_32() - data->last_tx_ms >= REFRESH_MS) {
+        changed = true;
+    }
+
+    filter_cycles = k_cycle_get_32() - start;
+    data->stats.filter_cycles += filter_cycles;
+    data->stats.max_filter_cycles = MAX(data->stats.max_filter_cycles, filter_cycles);
+
+    if (!changed) {
+        data->stats.skipped++;
+        return 0;
+    }
+
+    memcpy(data->last, data->tx, len * sizeof(data->tx[0]));
+    data->last_len = len;
+    data->valid = true;
+    data->powered = powered;
+    data->last_tx_ms = k_uptime_get_32();
+
+    start = k_cycle_get_32();
+    err = led_strip_update_rgb(strip, data->tx, len);
+    transfer_cycles = k_cycle_get_32() - start;
+
+    data->stats.transfers++;
+    data->stats.transfer_cycles += transfer_cycles;
+    data->stats.max_transfer_cycles = MAX(data->stats.max_transfer_cycles, transfer_cycles);
+
+    if (err) {
+        // Whatever the strip shows now is unknown, send the next frame regardless
+        data->valid = false;
+    }
+
+    return err;
+}
+
+// Raw channel writes bypass the cache and leave the strip in an unknown state
+static int led_strip_cache_update_channels(const struct device *dev, uint8_t *channels,
+                                           size_t num_channels) {
+    struct led_strip_cache_data *data = dev->data;
+
+    data->valid = false;
+
+    return led_strip_update_channels(strip, channels, num_channels);
+}
+
+static const struct led_strip_driver_api led_strip_cache_api = {
+    .update_rgb = led_strip_cache_update_rgb,
+    .update_channels = led_strip_cache_update_channels,
+};
+
+#if IS_ENABLED(CONFIG_SHELL)
+static int cmd_ledcache_show(const struct shell *sh, size_t argc, char **argv) {
+    const struct led_strip_cache_stats *stats = &led_strip_cache_data.stats;
+    uint32_t elapsed_ms = MAX(1U, k_uptime_get_32() - stats->since_ms);
+    uint32_t checked = MAX(1U, stats->frames);
+    uint32_t sent = MAX(1U, stats->transfers);
+
+    shell_print(sh, "frames: %u, skipped: %u, transfers: %u (%u/min)", stats->frames,
+                stats->skipped, stats->transfers,
+                (uint32_t)((uint64_t)stats->transfers * 60000U / elapsed_ms));
+    shell_print(sh, "filter: mean %u us, max %u us per frame",
+                k_cyc_to_us_ceil32((uint32_t)(stats->filter_cycles / checked)),
+                k_cyc_to_us_ceil32(stats->max_filter_cycles));
+    shell_print(sh, "transfer: mean %u us, max %u us per frame",
+                k_cyc_to_us_ceil32((uint32_t)(stats->transfer_cycles / sent)),
+                k_cyc_to_us_ceil32(stats->max_transfer_cycles));
+
+    return 0;
+}
+
+static int cmd_ledcache_reset(const struct shell *sh, size_t argc, char **argv) {
+    led_strip_cache_data.stats = (struct led_strip_cache_stats){
+        .since_ms = k_uptime_get_32(),
+    };
+
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_ledcache,
+                               SHELL_CMD(show, NULL, "Print LED frame cache counters",
+                                         cmd_ledcache_show),
+                               SHELL_CMD(reset, NULL, "Clear LED frame cache counters",
+                                         cmd_ledcache_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(ledcache, &sub_ledcache, "LED strip frame cache", NULL);
+#endif
+
+static int led_strip_cache_init(const struct device *dev) {
+    if (!device_is_ready(strip)) {
+        LOG_ERR("LED strip %s not ready", strip->name);
+        return -ENODEV;
+    }
+
+#if GAMMA_CORRECT
+    gamma_table_init();
+#endif
+
+    return 0;
+}
+
+DEVICE_DT_INST_DEFINE(0, led_strip_cache_init, NULL, &led_strip_cache_data, NULL, POST_KERNEL,
+                      CONFIG_DEEMEN17_LED_STRIP_CACHE_INIT_PRIORITY, &led_strip_cache_api);
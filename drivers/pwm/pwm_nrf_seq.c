@@ -0,0 +1,375 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_nrf_pwm_seq
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/pinctrl.h>
+#include <zephyr/drivers/pwm.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+#include <nrfx_pwm.h>
+
+#include <deemen17/pwm_seq.h>
+#include <deemen17/pwm_share.h>
+
+LOG_MODULE_REGISTER(pwm_nrf_seq, CONFIG_PWM_LOG_LEVEL);
+
+// Waveform load mode: three compare channels, the fourth word is COUNTERTOP
+#define PWM_NRF_SEQ_CHANNELS 3
+#define PWM_NRF_SEQ_CLOCK_HZ 16000000U
+#define PWM_NRF_SEQ_TOP_MAX 32767U
+#define PWM_NRF_SEQ_POLARITY BIT(15) // Output starts active, falls at the compare value
+
+#define PWM_NODE DT_DRV_INST(0)
+
+#if DT_SAME_NODE(PWM_NODE, DT_NODELABEL(pwm1))
+#define PWM_NRF_SEQ_IDX 1
+#elif DT_SAME_NODE(PWM_NODE, DT_NODELABEL(pwm2))
+#define PWM_NRF_SEQ_IDX 2
+#elif DT_SAME_NODE(PWM_NODE, DT_NODELABEL(pwm3))
+#define PWM_NRF_SEQ_IDX 3
+#else
+#error "deemen17,nrf-pwm-seq needs a PWM instance of its own, pwm1 to pwm3"
+#endif
+
+#define PWM_NRF_SEQ_IRQ_HANDLER NRFX_CONCAT_3(nrfx_pwm_, PWM_NRF_SEQ_IDX, _irq_handler)
+
+#define PWM_NRF_SEQ_MAX_ENTRIES DT_INST_PROP(0, max_entries)
+#define PWM_NRF_SEQ_REFRESH DT_INST_PROP(0, refresh)
+
+// Channel and playback state is shared by every pwm_set_cycles() caller, the
+// sequence owner and the PWM interrupt, and only changes under the lock
+struct pwm_nrf_seq_data {
+    nrfx_pwm_t pwm;
+    struct k_spinlock lock;
+    // Read by EasyDMA, so both live in RAM for the whole playback
+    nrf_pwm_values_wave_form_t steady;
+    nrf_pwm_values_wave_form_t entries[PWM_NRF_SEQ_MAX_ENTRIES];
+    // Channels share one period, arbitrated as in deemen17/pwm_share.h
+    struct pwm_share_channel channels[PWM_NRF_SEQ_CHANNELS];
+    struct pwm_share share;
+    bool running;  // Steady waveform or sequence playing
+    bool sequence; // A sequence, rather than the steady waveform, is playing
+    uint8_t seq_channel;
+    pwm_seq_done_t done;
+    void *user_data;
+    uint32_t sequences;
+};
+
+static struct pwm_nrf_seq_data pwm_nrf_seq_data = {
+    .pwm = NRFX_PWM_INSTANCE(PWM_NRF_SEQ_IDX),
+    .share = PWM_SHARE_INITIALIZER(pwm_nrf_seq_data.channels),
+};
+
+PINCTRL_DT_INST_DEFINE(0);
+
+static inline uint16_t compare_value(uint32_t pulse_cycles, pwm_flags_t flags) {
+    uint16_t value = MIN(pulse_cycles, PWM_NRF_SEQ_TOP_MAX);
+
+    return (flags & PWM_POLARITY_INVERTED) ? value : (value | PWM_NRF_SEQ_POLARITY);
+}
+
+static inline uint32_t ns_to_cycles(uint32_t ns) {
+    return (uint32_t)(((uint64_t)ns * PWM_NRF_SEQ_CLOCK_HZ) / NSEC_PER_SEC);
+}
+
+// A steady channel's compare value at another period, same duty cycle
+static uint16_t steady_compare(const struct pwm_nrf_seq_data *data, uint32_t channel,
+                               uint32_t period_cycles) {
+    const struct pwm_share_channel *ch = &data->channels[channel];
+
+    if (!pwm_share_active(ch)) {
+        return compare_value(0, 0);
+    }
+
+    return compare_value(pwm_share_pulse(&data->share, channel, period_cycles), ch->flags);
+}
+
+// One entry at period_cycles; the other channels keep their steady duty cycle
+static void pwm_nrf_seq_entry(const struct pwm_nrf_seq_data *data,
+                              nrf_pwm_values_wave_form_t *entry, uint32_t channel,
+                              uint32_t period_cycles, uint32_t pulse_cycles, pwm_flags_t flags) {
+    uint16_t *compare = &entry->channel_0;
+
+    for (int ch = 0; ch < PWM_NRF_SEQ_CHANNELS; ch++) {
+        compare[ch] = steady_compare(data, ch, period_cycles);
+    }
+    compare[channel] = compare_value(pulse_cycles, flags);
+    entry->counter_top = period_cycles;
+}
+
+static void pwm_nrf_seq_steady_entry(struct pwm_nrf_seq_data *data) {
+    uint16_t *compare = &data->steady.channel_0;
+
+    for (int ch = 0; ch < PWM_NRF_SEQ_CHANNELS; ch++) {
+        compare[ch] = steady_compare(data, ch, data->share.period_cycles);
+    }
+    data->steady.counter_top = data->share.period_cycles;
+}
+
+static void pwm_nrf_seq_loop_steady(struct pwm_nrf_seq_data *data) {
+    nrf_pwm_sequence_t seq = {
+        .values.p_wave_form = &data->steady,
+        .length = NRF_PWM_VALUES_LENGTH(data->steady),
+    };
+
+    // A loop never finishes, and its end-of-loop events must not pass for a sequence's
+    nrfx_pwm_simple_playback(&data->pwm, &seq, 1,
+                             NRFX_PWM_FLAG_LOOP | NRFX_PWM_FLAG_NO_EVT_FINISHED);
+    data->running = true;
+}
+
+// Give the outputs back to the steady channels, if any is on
+static void pwm_nrf_seq_resume_steady(struct pwm_nrf_seq_data *data) {
+    if (data->share.period_cycles) {
+        pwm_nrf_seq_steady_entry(data);
+        pwm_nrf_seq_loop_steady(data);
+    }
+}
+
+// Stop playback without reporting it; safe to call when already stopped
+static void pwm_nrf_seq_halt(struct pwm_nrf_seq_data *data) {
+    data->done = NULL;
+    if (data->running) {
+        nrfx_pwm_stop(&data->pwm, true);
+        data->running = false;
+        data->sequence = false;
+    }
+}
+
+static void pwm_nrf_seq_handler(nrfx_pwm_evt_type_t event, void *context) {
+    struct pwm_nrf_seq_data *data = context;
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    pwm_seq_done_t done = data->done;
+    void *user_data = data->user_data;
+
+    // Starting a playback clears the events of the one it replaced, so a finish
+    // seen here belongs to the sequence that is current
+    if (event != NRFX_PWM_EVT_FINISHED || !data->sequence) {
+        k_spin_unlock(&data->lock, key);
+        return;
+    }
+
+    data->running = false;
+    data->sequence = false;
+    data->done = NULL;
+
+    pwm_nrf_seq_resume_steady(data);
+    k_spin_unlock(&data->lock, key);
+
+    if (done) {
+        done(DEVICE_DT_INST_GET(0), user_data);
+    }
+}
+
+static int pwm_nrf_seq_set_cycles(const struct device *dev, uint32_t channel,
+                                  uint32_t period_cycles, uint32_t pulse_cycles,
+                                  pwm_flags_t flags) {
+    struct pwm_nrf_seq_data *data = dev->data;
+    uint32_t period;
+
+    if (channel >= PWM_NRF_SEQ_CHANNELS || period_cycles > PWM_NRF_SEQ_TOP_MAX) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    if (data->sequence && data->seq_channel == channel) {
+        // Setting the sequence's own channel takes it over
+        pwm_nrf_seq_halt(data);
+    }
+
+    period = pwm_share_set(&data->share, channel, period_cycles, pulse_cycles, flags);
+
+    if (data->sequence) {
+        // The new duty cycle is picked up when the sequence hands back
+    } else if (!period) {
+        // Every channel is off, the pins fall back to their inactive GPIO level
+        pwm_nrf_seq_halt(data);
+    } else {
+        // While looping the single entry is re-read every period, so updating it is enough
+        pwm_nrf_seq_steady_entry(data);
+        if (!data->running) {
+            pwm_nrf_seq_loop_steady(data);
+        }
+    }
+
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+static int pwm_nrf_seq_get_cycles_per_sec(const struct device *dev, uint32_t channel,
+                                          uint64_t *cycles) {
+    *cycles = PWM_NRF_SEQ_CLOCK_HZ;
+    return 0;
+}
+
+// Each entry is held for REFRESH + 1 periods. Steps that are not a whole number of
+// entries are rejected rather than rounded, the caller has to round them itself.
+static int pwm_nrf_seq_play(const struct device *dev, uint32_t channel, pwm_flags_t flags,
+                            const struct pwm_seq_step *steps, size_t count, pwm_seq_done_t done,
+                            void *user_data) {
+    struct pwm_nrf_seq_data *data = dev->data;
+    size_t length = 0;
+
+    if (channel >= PWM_NRF_SEQ_CHANNELS || count == 0) {
+        return -EINVAL;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        uint32_t period_cycles = ns_to_cycles(steps[i].period_ns);
+
+        if (period_cycles == 0 || period_cycles > PWM_NRF_SEQ_TOP_MAX || steps[i].periods == 0 ||
+            steps[i].periods % (PWM_NRF_SEQ_REFRESH + 1) != 0) {
+            return -EINVAL;
+        }
+
+        length += steps[i].periods / (PWM_NRF_SEQ_REFRESH + 1);
+        if (length > PWM_NRF_SEQ_MAX_ENTRIES) {
+            return -ENOMEM;
+        }
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    // The entries are in use until the sequence in progress is stopped; a steady
+    // waveform keeps playing until the new sequence is ready to replace it
+    if (data->sequence) {
+        pwm_nrf_seq_halt(data);
+        pwm_nrf_seq_resume_steady(data);
+    }
+
+    length = 0;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t period_cycles = ns_to_cycles(steps[i].period_ns);
+        uint32_t pulse_cycles = ns_to_cycles(steps[i].pulse_ns);
+        uint32_t entries = steps[i].periods / (PWM_NRF_SEQ_REFRESH + 1);
+
+        for (uint32_t e = 0; e < entries; e++) {
+            pwm_nrf_seq_entry(data, &data->entries[length++], channel, period_cycles,
+                              pulse_cycles, flags);
+        }
+    }
+
+    pwm_nrf_seq_halt(data);
+
+    nrf_pwm_sequence_t seq = {
+        .values.p_wave_form = data->entries,
+        .length = length * NRF_PWM_VALUES_LENGTH(data->entries[0]),
+        .repeats = PWM_NRF_SEQ_REFRESH,
+    };
+
+    data->done = done;
+    data->user_data = user_data;
+    data->running = true;
+    data->sequence = true;
+    data->seq_channel = channel;
+    data->sequences++;
+    nrfx_pwm_simple_playback(&data->pwm, &seq, 1, NRFX_PWM_FLAG_STOP);
+
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+static int pwm_nrf_seq_stop(const struct device *dev) {
+    struct pwm_nrf_seq_data *data = dev->data;
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    // Once this returns the done callback of the stopped sequence can no longer run
+    if (data->sequence) {
+        pwm_nrf_seq_halt(data);
+        pwm_nrf_seq_resume_steady(data);
+    }
+
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_SHELL)
+static int cmd_pwmseq(const struct shell *sh, size_t argc, char **argv) {
+    struct pwm_nrf_seq_data *data = &pwm_nrf_seq_data;
+    struct pwm_share_channel channels[PWM_NRF_SEQ_CHANNELS];
+    uint32_t uptime_s = MAX(1U, (uint32_t)(k_uptime_get() / MSEC_PER_SEC));
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    struct pwm_share share = data->share;
+    uint32_t sequences = data->sequences;
+
+    memcpy(channels, data->channels, sizeof(channels));
+    k_spin_unlock(&data->lock, key);
+
+    shell_print(sh, "%u updates, %u period changes (%u.%03u/s), %u sequences", share.updates,
+                share.period_changes, share.period_changes / uptime_s,
+                (uint32_t)((uint64_t)(share.period_changes % uptime_s) * 1000U / uptime_s),
+                sequences);
+
+    for (int ch = 0; ch < PWM_NRF_SEQ_CHANNELS; ch++) {
+        const struct pwm_share_channel *c = &channels[ch];
+
+        shell_print(sh, "ch%d: period %u, pulse %u cycles", ch, c->period_cycles,
+                    c->pulse_cycles);
+    }
+
+    return 0;
+}
+
+SHELL_CMD_REGISTER(pwmseq, NULL, "PWM sequence driver channel state and counters", cmd_pwmseq);
+#endif
+
+static const struct pwm_seq_driver_api pwm_nrf_seq_api = {
+    .pwm =
+        {
+            .set_cycles = pwm_nrf_seq_set_cycles,
+            .get_cycles_per_sec = pwm_nrf_seq_get_cycles_per_sec,
+        },
+    .play = pwm_nrf_seq_play,
+    .stop = pwm_nrf_seq_stop,
+};
+
+static int pwm_nrf_seq_init(const struct device *dev) {
+    struct pwm_nrf_seq_data *data = dev->data;
+    nrfx_pwm_config_t config = {
+        .output_pins = {NRF_PWM_PIN_NOT_CONNECTED, NRF_PWM_PIN_NOT_CONNECTED,
+                        NRF_PWM_PIN_NOT_CONNECTED, NRF_PWM_PIN_NOT_CONNECTED},
+        .irq_priority = DT_INST_IRQ(0, priority),
+        .base_clock = NRF_PWM_CLK_16MHz,
+        .count_mode = NRF_PWM_MODE_UP,
+        .top_value = PWM_NRF_SEQ_TOP_MAX,
+        .load_mode = NRF_PWM_LOAD_WAVE_FORM,
+        .step_mode = NRF_PWM_STEP_AUTO,
+        // Pins are routed by pinctrl
+        .skip_gpio_cfg = true,
+        .skip_psel_cfg = true,
+    };
+    int err;
+
+    err = pinctrl_apply_state(PINCTRL_DT_INST_DEV_CONFIG_GET(0), PINCTRL_STATE_DEFAULT);
+    if (err) {
+        return err;
+    }
+
+    IRQ_CONNECT(DT_INST_IRQN(0), DT_INST_IRQ(0, priority), nrfx_isr, PWM_NRF_SEQ_IRQ_HANDLER, 0);
+
+    if (nrfx_pwm_init(&data->pwm, &config, pwm_nrf_seq_handler, data) != NRFX_SUCCESS) {
+        LOG_ERR("Failed to initialize %s", dev->name);
+        return -EBUSY;
+    }
+
+    return 0;
+}
+
+DEVICE_DT_INST_DEFINE(0, pwm_nrf_seq_init, NULL, &pwm_nrf_seq_data, NULL, POST_KERNEL,
+                      CONFIG_PWM_INIT_PRIORITY, &pwm_nrf_seq_api);
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <deemen17/pwm_share.h>
+
+uint32_t pwm_share_set(struct pwm_share *share, uint32_t channel, uint32_t period_cycles,
+                       uint32_t pulse_cycles, pwm_flags_t flags) {
+    struct pwm_share_channel *ch = &share->channels[channel];
+    uint32_t period = 0;
+
+    *ch = (struct pwm_share_channel){
+        .period_cycles = period_cycles,
+        .pulse_cycles = period_cycles ? pulse_cycles : 0,
+        .flags = flags,
+    };
+    share->updates++;
+
+    // The channel just set owns the period; otherwise keep the current one while
+    // some active channel still wants it, so the others are not retimed
+    if (pwm_share_active(ch)) {
+        period = period_cycles;
+    } else {
+        for (int i = 0; i < share->channels_len; i++) {
+            if (!pwm_share_active(&share->channels[i])) {
+                continue;
+            }
+            if (!period || share->channels[i].period_cycles == share->period_cycles) {
+                period = share->channels[i].period_cycles;
+            }
+        }
+    }
+
+    if (period != share->period_cycles && period && share->period_cycles) {
+        share->period_changes++;
+    }
+    share->period_cycles = period;
+
+    return period;
+}
+
+uint32_t pwm_share_pulse(const struct pwm_share *share, uint32_t channel, uint32_t period_cycles) {
+    const struct pwm_share_channel *ch = &share->channels[channel];
+
+    if (!pwm_share_active(ch)) {
+        return 0;
+    }
+
+    if (ch->period_cycles == period_cycles) {
+        return ch->pulse_cycles;
+    }
+
+    return (uint64_t)ch->pulse_cycles * period_cycles / ch->period_cycles;
+}
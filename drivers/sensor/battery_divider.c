@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_battery_voltage_divider
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/adc.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <deemen17/battery_divider.h>
+
+LOG_MODULE_REGISTER(battery_divider, CONFIG_SENSOR_LOG_LEVEL);
+
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1,
+             "Exactly one deemen17,battery-voltage-divider node is supported");
+
+#define FILTER_WINDOW 5
+#define SAG_REJECT_MAX 2 // Consecutive sags after which the drop is taken as real
+#define ADC_RESOLUTION 12
+
+#define HAS_POWER_GPIO DT_INST_NODE_HAS_PROP(0, power_gpios)
+
+struct battery_divider_config {
+    const struct device *adc;
+    uint8_t channel;
+    uint32_t output_ohms;
+    uint32_t full_ohms;
+#if HAS_POWER_GPIO
+    struct gpio_dt_spec power;
+#endif
+};
+
+struct battery_divider_data {
+    struct adc_channel_cfg channel_cfg;
+    struct adc_sequence sequence;
+    int16_t raw;
+    // Last FILTER_WINDOW accepted readings, oldest overwritten first
+    uint16_t window_mv[FILTER_WINDOW];
+    uint8_t window_len;
+    uint8_t window_next;
+    uint8_t sags;
+    uint16_t median_mv;
+    int64_t hold_off_until;
+};
+
+static const struct battery_divider_config battery_divider_config = {
+    .adc = DEVICE_DT_GET(DT_INST_IO_CHANNELS_CTLR(0)),
+    .channel = DT_INST_IO_CHANNELS_INPUT(0),
+    .output_ohms = DT_INST_PROP(0, output_ohms),
+    .full_ohms = DT_INST_PROP(0, full_ohms),
+#if HAS_POWER_GPIO
+    .power = GPIO_DT_SPEC_INST_GET(0, power_gpios),
+#endif
+};
+
+static struct battery_divider_data battery_divider_data;
+
+// Median of the window by insertion sort, at most FILTER_WINDOW entries
+static uint16_t window_median(const struct battery_divider_data *data) {
+    uint16_t sorted[FILTER_WINDOW];
+
+    for (int i = 0; i < data->window_len; i++) {
+        uint16_t mv = data->window_mv[i];
+        int j = i;
+
+        for (; j > 0 && sorted[j - 1] > mv; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = mv;
+    }
+
+    return sorted[data->window_len / 2];
+}
+
+static void filter_add(struct battery_divider_data *data, uint16_t mv) {
+    bool sag = data->window_len > 0 && mv + DT_INST_PROP(0, sag_reject_mv) < data->median_mv;
+
+    if (sag && data->sags < SAG_REJECT_MAX) {
+        data->sags++;
+        LOG_DBG("Dropped %u mV reading as a load sag", mv);
+        return;
+    }
+
+    // Past the limit the drop is real: low readings keep going in until the median
+    // has caught up with them, only a reading near the median starts counting anew
+    if (!sag) {
+        data->sags = 0;
+    }
+    data->window_mv[data->window_next] = mv;
+    data->window_next = (data->window_next + 1) % FILTER_WINDOW;
+    data->window_len = MIN(data->window_len + 1, FILTER_WINDOW);
+    data->median_mv = window_median(data);
+}
+
+static int battery_divider_read_mv(const struct device *dev, uint16_t *mv) {
+    const struct battery_divider_config *config = dev->config;
+    struct battery_divider_data *data = dev->data;
+    int32_t val;
+    int err;
+
+#if HAS_POWER_GPIO
+    err = gpio_pin_set_dt(&config->power, 1);
+    if (err) {
+        return err;
+    }
+    k_usleep(DT_INST_PROP(0, power_settle_us));
+#endif
+
+    // One sequence, the SAADC averages the oversampled burst itself
+    err = adc_read(config->adc, &data->sequence);
+
+#if HAS_POWER_GPIO
+    gpio_pin_set_dt(&config->power, 0);
+#endif
+
+    if (err) {
+        return err;
+    }
+
+    val = data->raw;
+    err = adc_raw_to_millivolts(adc_ref_internal(config->adc), data->channel_cfg.gain,
+                                data->sequence.resolution, &val);
+    if (err) {
+        return err;
+    }
+
+    *mv = (uint16_t)((uint64_t)MAX(val, 0) * config->full_ohms / config->output_ohms);
+    return 0;
+}
+
+static int battery_divider_sample_fetch(const struct device *dev, enum sensor_channel chan) {
+    struct battery_divider_data *data = dev->data;
+    uint16_t mv;
+    int err;
+
+    switch (chan) {
+    case SENSOR_CHAN_ALL:
+    case SENSOR_CHAN_GAUGE_VOLTAGE:
+    case SENSOR_CHAN_GAUGE_STATE_OF_CHARGE:
+        break;
+    default:
+        return -ENOTSUP;
+    }
+
+    if (data->window_len > 0 && k_uptime_get() < data->hold_off_until) {
+        return 0;
+    }
+
+    err = battery_divider_read_mv(dev, &mv);
+    if (err) {
+        LOG_ERR("Failed to read battery voltage (%d)", err);
+        return err;
+    }
+
+    filter_add(data, mv);
+    LOG_DBG("Battery %u mV, filtered %u mV", mv, data->median_mv);
+
+    return 0;
+}
+
+// Linear fit of a lithium-ion discharge curve, as zmk,battery-voltage-divider uses
+static uint8_t lithium_ion_mv_to_pct(uint16_t mv) {
+    if (mv >= 4200) {
+        return 100;
+    } else if (mv <= 3450) {
+        return 0;
+    }
+
+    return mv * 2 / 15 - 459;
+}
+
+static int battery_divider_channel_get(const struct device *dev, enum sensor_channel chan,
+                                       struct sensor_value *val) {
+    struct battery_divider_data *data = dev->data;
+
+    switch (chan) {
+    case SENSOR_CHAN_GAUGE_VOLTAGE:
+        val->val1 = data->median_mv / 1000;
+        val->val2 = (data->median_mv % 1000) * 1000;
+        return 0;
+    case SENSOR_CHAN_GAUGE_STATE_OF_CHARGE:
+        val->val1 = lithium_ion_mv_to_pct(data->median_mv);
+        val->val2 = 0;
+        return 0;
+    default:
+        return -ENOTSUP;
+    }
+}
+
+static int battery_divider_attr_set(const struct device *dev, enum sensor_channel chan,
+                                    enum sensor_attribute attr, const struct sensor_value *val) {
+    struct battery_divider_data *data = dev->data;
+
+    if (chan != SENSOR_CHAN_GAUGE_VOLTAGE || attr != BATTERY_DIVIDER_ATTR_HOLD_OFF) {
+        return -ENOTSUP;
+    }
+
+    data->hold_off_until = MAX(data->hold_off_until, k_uptime_get() + val->val1);
+    return 0;
+}
+
+static const struct sensor_driver_api battery_divider_api = {
+    .attr_set = battery_divider_attr_set,
+    .sample_fetch = battery_divider_sample_fetch,
+    .channel_get = battery_divider_channel_get,
+};
+
+static int battery_divider_init(const struct device *dev) {
+    const struct battery_divider_config *config = dev->config;
+    struct battery_divider_data *data = dev->data;
+    int err;
+
+    if (!device_is_ready(config->adc)) {
+        LOG_ERR("ADC %s not ready", config->adc->name);
+        return -ENODEV;
+    }
+
+#if HAS_POWER_GPIO
+    if (!gpio_is_ready_dt(&config->power)) {
+        LOG_ERR("Divider power GPIO not ready");
+        return -ENODEV;
+    }
+
+    err = gpio_pin_configure_dt(&config->power, GPIO_OUTPUT_INACTIVE);
+    if (err) {
+        return err;
+    }
+#endif
+
+#ifdef CONFIG_ADC_NRFX_SAADC
+    // The divider is a high impedance source, give the sampling capacitor 40 us
+    data->channel_cfg = (struct adc_channel_cfg){
+        .gain = ADC_GAIN_1_6,
+        .reference = ADC_REF_INTERNAL,
+        .acquisition_time = ADC_ACQ_TIME(ADC_ACQ_TIME_MICROSECONDS, 40),
+        .channel_id = config->channel,
+        .input_positive = SAADC_CH_PSELP_PSELP_AnalogInput0 + config->channel,
+    };
+#elif defined(CONFIG_ADC_EMUL)
+    // native_sim tests, the emulator takes only its default acquisition time
+    data->channel_cfg = (struct adc_channel_cfg){
+        .gain = ADC_GAIN_1,
+        .reference = ADC_REF_INTERNAL,
+        .acquisition_time = ADC_ACQ_TIME_DEFAULT,
+        .channel_id = config->channel,
+    };
+#else
+#error Unsupported ADC
+#endif
+
+    data->sequence = (struct adc_sequence){
+        .channels = BIT(config->channel),
+        .buffer = &data->raw,
+        .buffer_size = sizeof(data->raw),
+        .resolution = ADC_RESOLUTION,
+        .oversampling = DT_INST_PROP(0, oversampling),
+        .calibrate = true,
+    };
+
+    err = adc_channel_setup(config->adc, &data->channel_cfg);
+    if (err) {
+        LOG_ERR("Failed to set up ADC channel %u (%d)", config->channel, err);
+        return err;
+    }
+
+    // Only the first conversion needs the offset calibration
+    err = battery_divider_sample_fetch(dev, SENSOR_CHAN_GAUGE_VOLTAGE);
+    data->sequence.calibrate = false;
+
+    return err;
+}
+
+SENSOR_DEVICE_DT_INST_DEFINE(0, battery_divider_init, NULL, &battery_divider_data,
+                             &battery_divider_config, POST_KERNEL, CONFIG_SENSOR_INIT_PRIORITY,
+                             &battery_divider_api);
@@ -0,0 +1,248 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_max17048
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/byteorder.h>
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+#include <deemen17/max17048.h>
+
+LOG_MODULE_REGISTER(max17048, CONFIG_SENSOR_LOG_LEVEL);
+
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1,
+             "Exactly one deemen17,max17048 node is supported");
+
+// VCELL and SOC are adjacent, one burst read covers both
+#define MAX17048_REG_VCELL 0x02
+#define MAX17048_REG_SOC 0x04
+#define MAX17048_BURST_LEN 4
+
+#define MAX17048_VCELL_NV_PER_LSB 78125
+
+#define INTERVAL_MIN_S CONFIG_DEEMEN17_MAX17048_INTERVAL_MIN_S
+#define INTERVAL_MAX_S CONFIG_DEEMEN17_MAX17048_INTERVAL_MAX_S
+
+BUILD_ASSERT(INTERVAL_MIN_S > 0 && INTERVAL_MIN_S <= INTERVAL_MAX_S,
+             "MAX17048 sampling interval range is empty");
+
+struct max17048_config {
+    struct i2c_dt_spec i2c;
+};
+
+struct max17048_data {
+    const struct device *dev;
+    struct k_work_delayable sample_work;
+    struct k_spinlock lock; // Guards everything below
+    // Last reading, served to sample fetches
+    uint32_t vcell_uv;
+    uint16_t soc; // 1/256 %
+    uint32_t interval_s;
+    bool external_power;
+    uint32_t transactions;
+};
+
+static int max17048_read(const struct device *dev) {
+    const struct max17048_config *config = dev->config;
+    struct max17048_data *data = dev->data;
+    uint8_t buf[MAX17048_BURST_LEN];
+    int err;
+
+    err = i2c_burst_read_dt(&config->i2c, MAX17048_REG_VCELL, buf, sizeof(buf));
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    data->transactions++;
+    if (err) {
+        k_spin_unlock(&data->lock, key);
+        return err;
+    }
+
+    data->vcell_uv = (uint32_t)sys_get_be16(&buf[0]) * MAX17048_VCELL_NV_PER_LSB / 1000U;
+    data->soc = sys_get_be16(&buf[MAX17048_REG_SOC - MAX17048_REG_VCELL]);
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+// Sample sooner while the percentage moves, back off while it holds still
+static void max17048_sample(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct max17048_data *data = CONTAINER_OF(dwork, struct max17048_data, sample_work);
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    uint8_t percent = data->soc >> 8;
+    uint32_t vcell_uv, interval_s;
+    uint16_t soc;
+    int err;
+
+    k_spin_unlock(&data->lock, key);
+
+    err = max17048_read(data->dev);
+
+    key = k_spin_lock(&data->lock);
+    if (err) {
+        data->interval_s = INTERVAL_MIN_S;
+    } else if (data->external_power) {
+        data->interval_s = INTERVAL_MIN_S;
+    } else if ((data->soc >> 8) != percent) {
+        data->interval_s = MAX(data->interval_s / 2, INTERVAL_MIN_S);
+    } else {
+        data->interval_s = MIN(data->interval_s * 2, INTERVAL_MAX_S);
+    }
+    interval_s = data->interval_s;
+    vcell_uv = data->vcell_uv;
+    soc = data->soc;
+    k_spin_unlock(&data->lock, key);
+
+    if (err) {
+        LOG_WRN("Failed to read fuel gauge (%d)", err);
+    }
+    LOG_DBG("SoC %u%%, %u uV, next sample in %u s", soc >> 8, vcell_uv, interval_s);
+    k_work_schedule(dwork, K_SECONDS(interval_s));
+}
+
+// No bus traffic, the background sampler keeps the reading current
+static int max17048_sample_fetch(const struct device *dev, enum sensor_channel chan) {
+    switch (chan) {
+    case SENSOR_CHAN_ALL:
+    case SENSOR_CHAN_GAUGE_STATE_OF_CHARGE:
+    case SENSOR_CHAN_GAUGE_VOLTAGE:
+        return 0;
+    default:
+        return -ENOTSUP;
+    }
+}
+
+static int max17048_channel_get(const struct device *dev, enum sensor_channel chan,
+                                struct sensor_value *val) {
+    struct max17048_data *data = dev->data;
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    uint32_t vcell_uv = data->vcell_uv;
+    uint16_t soc = data->soc;
+
+    k_spin_unlock(&data->lock, key);
+
+    switch (chan) {
+    case SENSOR_CHAN_GAUGE_STATE_OF_CHARGE:
+        // The gauge reports above 100% near the top of a charge
+        if ((soc >> 8) >= 100) {
+            val->val1 = 100;
+            val->val2 = 0;
+        } else {
+            val->val1 = soc >> 8;
+            val->val2 = (int32_t)(((uint32_t)(soc & 0xff) * 1000000U) >> 8);
+        }
+        return 0;
+    case SENSOR_CHAN_GAUGE_VOLTAGE:
+        val->val1 = vcell_uv / 1000000U;
+        val->val2 = vcell_uv % 1000000U;
+        return 0;
+    default:
+        return -ENOTSUP;
+    }
+}
+
+static int max17048_attr_set(const struct device *dev, enum sensor_channel chan,
+                             enum sensor_attribute attr, const struct sensor_value *val) {
+    struct max17048_data *data = dev->data;
+    bool external_power = val->val1 != 0;
+    bool changed;
+
+    if (chan != SENSOR_CHAN_GAUGE_STATE_OF_CHARGE || attr != MAX17048_ATTR_EXTERNAL_POWER) {
+        return -ENOTSUP;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    changed = external_power != data->external_power;
+    if (changed) {
+        data->external_power = external_power;
+        data->interval_s = INTERVAL_MIN_S;
+    }
+    k_spin_unlock(&data->lock, key);
+
+    // Charging starts or stops moving the percentage, pick up the new trend now
+    if (changed) {
+        k_work_reschedule(&data->sample_work, K_NO_WAIT);
+    }
+
+    return 0;
+}
+
+static const struct sensor_driver_api max17048_api = {
+    .attr_set = max17048_attr_set,
+    .sample_fetch = max17048_sample_fetch,
+    .channel_get = max17048_channel_get,
+};
+
+#if IS_ENABLED(CONFIG_SHELL)
+static int cmd_fuelgauge(const struct shell *sh, size_t argc, char **argv) {
+    const struct device *dev = DEVICE_DT_INST_GET(0);
+    struct max17048_data *data = dev->data;
+    uint32_t uptime_s = MAX(1U, (uint32_t)(k_uptime_get() / MSEC_PER_SEC));
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    uint16_t soc = data->soc;
+    uint32_t vcell_uv = data->vcell_uv;
+    uint32_t interval_s = data->interval_s;
+    bool external_power = data->external_power;
+    uint32_t transactions = data->transactions;
+
+    k_spin_unlock(&data->lock, key);
+
+    shell_print(sh, "SoC %u%%, %u mV%s", soc >> 8, vcell_uv / 1000U,
+                external_power ? ", external power" : "");
+    shell_print(sh, "sampling every %u s", interval_s);
+    shell_print(sh, "%u I2C transactions, %u per hour", transactions,
+                (uint32_t)((uint64_t)transactions * 3600U / uptime_s));
+
+    return 0;
+}
+
+SHELL_CMD_REGISTER(fuelgauge, NULL, "MAX17048 reading and sampling counters", cmd_fuelgauge);
+#endif
+
+static int max17048_init(const struct device *dev) {
+    const struct max17048_config *config = dev->config;
+    struct max17048_data *data = dev->data;
+    int err;
+
+    if (!i2c_is_ready_dt(&config->i2c)) {
+        LOG_ERR("I2C bus %s not ready", config->i2c.bus->name);
+        return -ENODEV;
+    }
+
+    data->dev = dev;
+    data->interval_s = INTERVAL_MIN_S;
+    k_work_init_delayable(&data->sample_work, max17048_sample);
+
+    // Battery reporting fetches right after boot, have a reading ready for it
+    err = max17048_read(dev);
+    if (err) {
+        LOG_ERR("Failed to read fuel gauge (%d)", err);
+        return err;
+    }
+
+    k_work_schedule(&data->sample_work, K_SECONDS(data->interval_s));
+
+    return 0;
+}
+
+static const struct max17048_config max17048_config = {
+    .i2c = I2C_DT_SPEC_INST_GET(0),
+};
+
+static struct max17048_data max17048_data;
+
+SENSOR_DEVICE_DT_INST_DEFINE(0, max17048_init, NULL, &max17048_data, &max17048_config, POST_KERNEL,
+                             CONFIG_SENSOR_INIT_PRIORITY, &max17048_api);
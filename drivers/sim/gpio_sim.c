@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_gpio_sim
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/drivers/gpio/gpio_utils.h>
+#include <zephyr/kernel.h>
+
+#include <deemen17/sim.h>
+
+struct gpio_sim_config {
+    // gpio_driver_config needs to be first
+    struct gpio_driver_config common;
+};
+
+struct gpio_sim_data {
+    // gpio_driver_data needs to be first
+    struct gpio_driver_data common;
+    struct k_spinlock lock;
+    sys_slist_t callbacks;
+
+    gpio_port_value_t input;
+    gpio_port_value_t output;
+    gpio_port_pins_t output_en;
+
+    gpio_port_pins_t int_en;
+    gpio_port_pins_t int_level; // Level triggered, otherwise edge
+    gpio_port_pins_t int_high;  // Rising edge or high level
+    gpio_port_pins_t int_low;   // Falling edge or low level
+};
+
+static gpio_sim_output_hook_t output_hook;
+static void *output_hook_data;
+
+void gpio_sim_set_output_hook(gpio_sim_output_hook_t hook, void *user_data) {
+    output_hook_data = user_data;
+    output_hook = hook;
+}
+
+// Pins whose interrupt condition holds for an input change from old to new
+static gpio_port_pins_t gpio_sim_triggered(const struct gpio_sim_data *data,
+                                           gpio_port_value_t old, gpio_port_value_t new) {
+    gpio_port_pins_t changed = old ^ new;
+    gpio_port_pins_t edge = ~data->int_level;
+    gpio_port_pins_t level = data->int_level;
+    gpio_port_pins_t pins = 0;
+
+    pins |= changed & new & edge & data->int_high;
+    pins |= changed & ~new & edge & data->int_low;
+    pins |= new & level & data->int_high;
+    pins |= ~new & level & data->int_low;
+
+    return pins & data->int_en & ~data->output_en;
+}
+
+// Apply a new output latch value, then trace and report the pins that changed level
+static void gpio_sim_update_output(const struct device *dev, gpio_port_value_t value) {
+    struct gpio_sim_data *data = dev->data;
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    gpio_port_pins_t changed = (data->output ^ value) & data->output_en;
+
+    data->output = value;
+    k_spin_unlock(&data->lock, key);
+
+    if (!changed) {
+        return;
+    }
+
+    for (gpio_pin_t pin = 0; pin < 32; pin++) {
+        if (changed & BIT(pin)) {
+            sim_trace_emit(dev->name, "pin=%u level=%u", pin, (value & BIT(pin)) ? 1 : 0);
+        }
+    }
+
+    if (output_hook) {
+        output_hook(dev, changed, output_hook_data);
+    }
+}
+
+int gpio_sim_output_get(const struct device *port, gpio_pin_t pin) {
+    const struct gpio_sim_data *data = port->data;
+
+    return (data->output & BIT(pin)) ? 1 : 0;
+}
+
+int gpio_sim_input_set(const struct device *port, gpio_pin_t pin, int level) {
+    struct gpio_sim_data *data = port->data;
+    gpio_port_pins_t fired;
+
+    if (pin >= 32) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    gpio_port_value_t old = data->input;
+
+    WRITE_BIT(data->input, pin, level);
+    fired = gpio_sim_triggered(data, old, data->input) & BIT(pin);
+    k_spin_unlock(&data->lock, key);
+
+    if (fired) {
+        gpio_fire_callbacks(&data->callbacks, port, fired);
+    }
+
+    return 0;
+}
+
+static int gpio_sim_pin_configure(const struct device *dev, gpio_pin_t pin, gpio_flags_t flags) {
+    struct gpio_sim_data *data = dev->data;
+    gpio_port_value_t output = data->output;
+
+    if (flags & GPIO_OUTPUT) {
+        if (flags & GPIO_OUTPUT_INIT_HIGH) {
+            output |= BIT(pin);
+        } else if (flags & GPIO_OUTPUT_INIT_LOW) {
+            output &= ~BIT(pin);
+        }
+        data->output_en |= BIT(pin);
+    } else {
+        data->output_en &= ~BIT(pin);
+    }
+
+    if ((flags & GPIO_INPUT) && !(flags & GPIO_OUTPUT)) {
+        // Floating inputs settle to their pull resistor
+        if (flags & GPIO_PULL_UP) {
+            data->input |= BIT(pin);
+        } else if (flags & GPIO_PULL_DOWN) {
+            data->input &= ~BIT(pin);
+        }
+    }
+
+    gpio_sim_update_output(dev, output);
+
+    return 0;
+}
+
+static int gpio_sim_port_get_raw(const struct device *dev, gpio_port_value_t *value) {
+    const struct gpio_sim_data *data = dev->data;
+
+    // gpio_pin_get() and the port reads both end up here, one line per register read
+    if (IS_ENABLED(CONFIG_DEEMEN17_GPIO_SIM_TRACE_READS)) {
+        sim_trace_emit(dev->name, "read");
+    }
+
+    *value = (data->input & ~data->output_en) | (data->output & data->output_en);
+
+    return 0;
+}
+
+static int gpio_sim_port_set_masked_raw(const struct device *dev, gpio_port_pins_t mask,
+                                        gpio_port_value_t value) {
+    const struct gpio_sim_data *data = dev->data;
+
+    gpio_sim_update_output(dev, (data->output & ~mask) | (value & mask));
+
+    return 0;
+}
+
+static int gpio_sim_port_set_bits_raw(const struct device *dev, gpio_port_pins_t pins) {
+    const struct gpio_sim_data *data = dev->data;
+
+    gpio_sim_update_output(dev, data->output | pins);
+
+    return 0;
+}
+
+static int gpio_sim_port_clear_bits_raw(const struct device *dev, gpio_port_pins_t pins) {
+    const struct gpio_sim_data *data = dev->data;
+
+    gpio_sim_update_output(dev, data->output & ~pins);
+
+    return 0;
+}
+
+static int gpio_sim_port_toggle_bits(const struct device *dev, gpio_port_pins_t pins) {
+    const struct gpio_sim_data *data = dev->data;
+
+    gpio_sim_update_output(dev, data->output ^ pins);
+
+    return 0;
+}
+
+static int gpio_sim_pin_interrupt_configure(const struct device *dev, gpio_pin_t pin,
+                                            enum gpio_int_mode mode, enum gpio_int_trig trig) {
+    struct gpio_sim_data *data = dev->data;
+    gpio_port_pins_t fired = 0;
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    WRITE_BIT(data->int_en, pin, mode != GPIO_INT_MODE_DISABLED);
+    WRITE_BIT(data->int_level, pin, mode == GPIO_INT_MODE_LEVEL);
+    WRITE_BIT(data->int_high, pin, trig & GPIO_INT_TRIG_HIGH);
+    WRITE_BIT(data->int_low, pin, trig & GPIO_INT_TRIG_LOW);
+
+    // A level interrupt enabled while its level already holds fires right away
+    if (mode == GPIO_INT_MODE_LEVEL) {
+        fired = gpio_sim_triggered(data, data->input, data->input) & BIT(pin);
+    }
+
+    k_spin_unlock(&data->lock, key);
+
+    if (fired) {
+        gpio_fire_callbacks(&data->callbacks, dev, fired);
+    }
+
+    return 0;
+}
+
+static int gpio_sim_manage_callback(const struct device *dev, struct gpio_callback *callback,
+                                    bool set) {
+    struct gpio_sim_data *data = dev->data;
+
+    return gpio_manage_callback(&data->callbacks, callback, set);
+}
+
+static const struct gpio_driver_api gpio_sim_api = {
+    .pin_configure = gpio_sim_pin_configure,
+    .port_get_raw = gpio_sim_port_get_raw,
+    .port_set_masked_raw = gpio_sim_port_set_masked_raw,
+    .port_set_bits_raw = gpio_sim_port_set_bits_raw,
+    .port_clear_bits_raw = gpio_sim_port_clear_bits_raw,
+    .port_toggle_bits = gpio_sim_port_toggle_bits,
+    .pin_interrupt_configure = gpio_sim_pin_interrupt_configure,
+    .manage_callback = gpio_sim_manage_callback,
+};
+
+#define GPIO_SIM_INST(n)                                                                           \
+    static const struct gpio_sim_config gpio_sim_config_##n = {                                    \
+        .common = {.port_pin_mask = GPIO_PORT_PIN_MASK_FROM_DT_INST(n)},                           \
+    };                                                                                             \
+    static struct gpio_sim_data gpio_sim_data_##n;                                                 \
+    DEVICE_DT_INST_DEFINE(n, NULL, NULL, &gpio_sim_data_##n, &gpio_sim_config_##n, PRE_KERNEL_1,  \
+                          CONFIG_GPIO_INIT_PRIORITY, &gpio_sim_api);
+
+DT_INST_FOREACH_STATUS_OKAY(GPIO_SIM_INST)
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Counts how often the CPU goes idle, which is once per wakeup, over a fixed window
+// after boot. Every timer expiry, work item or interrupt that runs while the board is
+// otherwise idle shows up as one more entry.
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <deemen17/sim.h>
+
+#define WINDOW_START_MS (CONFIG_DEEMEN17_IDLE_COUNT_SIM_START_S * MSEC_PER_SEC)
+#define WINDOW_MS (CONFIG_DEEMEN17_IDLE_COUNT_SIM_WINDOW_S * MSEC_PER_SEC)
+
+static uint32_t idle_entries;
+static uint32_t window_start_entries;
+
+// Called by the idle thread right before the CPU halts
+void sys_trace_idle_user(void) { idle_entries++; }
+
+static void idle_count_window(struct k_timer *timer);
+static K_TIMER_DEFINE(window_timer, idle_count_window, NULL);
+
+static void idle_count_window(struct k_timer *timer) {
+    static bool started;
+    uint32_t wakeups;
+
+    if (!started) {
+        started = true;
+        window_start_entries = idle_entries;
+        return;
+    }
+
+    k_timer_stop(timer);
+
+    // The first idle entry in the window ends the start expiry's own wakeup
+    wakeups = idle_entries - window_start_entries - 1;
+    sim_trace_emit("idle", "wakeups=%u window_ms=%u", wakeups, WINDOW_MS);
+    LOG_INF("%u wakeups in %u s idle", wakeups, CONFIG_DEEMEN17_IDLE_COUNT_SIM_WINDOW_S);
+}
+
+static int idle_count_sim_init(void) {
+    k_timer_start(&window_timer, K_MSEC(WINDOW_START_MS), K_MSEC(WINDOW_MS));
+    return 0;
+}
+
+SYS_INIT(idle_count_sim_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
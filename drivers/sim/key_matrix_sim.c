@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_key_matrix_sim
+
+#include <stdlib.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/gpio.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#include <cmdline.h>
+#include <posix_native_task.h>
+
+#include <deemen17/sim.h>
+
+#include "sim_host_bottom.h"
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define KSCAN_NODE DT_INST_PHANDLE(0, kscan)
+
+#define ROWS DT_PROP_LEN(KSCAN_NODE, row_gpios)
+#define COLS DT_PROP_LEN(KSCAN_NODE, col_gpios)
+
+// diode-direction is an enum of "row2col", "col2row"
+#define COL2ROW (DT_ENUM_IDX(KSCAN_NODE, diode_direction) == 1)
+
+#define MATRIX_GPIO(node_id, prop, idx) GPIO_DT_SPEC_GET_BY_IDX(node_id, prop, idx)
+
+static const struct gpio_dt_spec rows[] = {
+    DT_FOREACH_PROP_ELEM_SEP(KSCAN_NODE, row_gpios, MATRIX_GPIO, (, ))};
+static const struct gpio_dt_spec cols[] = {
+    DT_FOREACH_PROP_ELEM_SEP(KSCAN_NODE, col_gpios, MATRIX_GPIO, (, ))};
+
+static bool pressed[ROWS][COLS];
+
+struct key_script_event {
+    uint32_t at_ms;
+    uint8_t row;
+    uint8_t col;
+    bool pressed;
+};
+
+static struct key_script_event script[CONFIG_DEEMEN17_KEY_MATRIX_SIM_MAX_EVENTS];
+static size_t script_len;
+static size_t script_next;
+static char *script_path;
+
+static bool gpio_active(const struct gpio_dt_spec *spec) {
+    bool level = gpio_sim_output_get(spec->port, spec->pin);
+
+    return (spec->dt_flags & GPIO_ACTIVE_LOW) ? !level : level;
+}
+
+static void gpio_sense(const struct gpio_dt_spec *spec, bool active) {
+    gpio_sim_input_set(spec->port, spec->pin, (spec->dt_flags & GPIO_ACTIVE_LOW) ? !active : active);
+}
+
+// Propagate the driven lines through closed switches to the sensed lines
+static void key_matrix_sim_update(void) {
+    if (COL2ROW) {
+        for (int r = 0; r < ROWS; r++) {
+            bool active = false;
+
+            for (int c = 0; c < COLS && !active; c++) {
+                active = pressed[r][c] && gpio_active(&cols[c]);
+            }
+            gpio_sense(&rows[r], active);
+        }
+    } else {
+        for (int c = 0; c < COLS; c++) {
+            bool active = false;
+
+            for (int r = 0; r < ROWS && !active; r++) {
+                active = pressed[r][c] && gpio_active(&rows[r]);
+            }
+            gpio_sense(&cols[c], active);
+        }
+    }
+}
+
+static void key_matrix_sim_output_changed(const struct device *port, gpio_port_pins_t changed,
+                                          void *user_data) {
+    key_matrix_sim_update();
+}
+
+int key_matrix_sim_set(uint8_t row, uint8_t col, bool state) {
+    if (row >= ROWS || col >= COLS) {
+        return -EINVAL;
+    }
+
+    pressed[row][col] = state;
+    sim_trace_emit("key_matrix", "row=%u col=%u pressed=%u", row, col, state);
+    key_matrix_sim_update();
+
+    return 0;
+}
+
+static void key_script_step(struct k_work *work);
+K_WORK_DELAYABLE_DEFINE(key_script_work, key_script_step);
+
+static void key_script_schedule_next(void) {
+    if (script_next >= script_len) {
+        return;
+    }
+
+    int64_t delay = (int64_t)script[script_next].at_ms - k_uptime_get();
+
+    k_work_schedule(&key_script_work, K_MSEC(MAX(delay, 0)));
+}
+
+static void key_script_step(struct k_work *work) {
+    const struct key_script_event *ev = &script[script_next++];
+
+    key_matrix_sim_set(ev->row, ev->col, ev->pressed);
+    key_script_schedule_next();
+}
+
+// Script lines are "<uptime_ms> <row> <col> <0|1>", '#' starts a comment
+static void key_script_load(void) {
+    char line[64];
+    int handle;
+
+    if (script_path == NULL) {
+        return;
+    }
+
+    handle = sim_host_open(script_path, 0);
+    if (handle < 0) {
+        printk("key_matrix_sim: unable to open %s\n", script_path);
+        return;
+    }
+
+    while (script_len < ARRAY_SIZE(script) && sim_host_read_line(handle, line, sizeof(line)) > 0) {
+        char *pos = line;
+        uint32_t fields[4];
+        int i;
+
+        for (i = 0; i < ARRAY_SIZE(fields); i++) {
+            char *end;
+
+            fields[i] = strtoul(pos, &end, 10);
+            if (end == pos) {
+                break;
+            }
+            pos = end;
+        }
+
+        if (i < ARRAY_SIZE(fields) || line[0] == '#') {
+            continue;
+        }
+
+        script[script_len++] = (struct key_script_event){
+            .at_ms = fields[0],
+            .row = fields[1],
+            .col = fields[2],
+            .pressed = fields[3] != 0,
+        };
+    }
+
+    sim_host_close(handle);
+}
+
+static void key_matrix_sim_add_options(void) {
+    static struct args_struct_t options[] = {
+        {.option = "key-script",
+         .name = "path",
+         .type = 's',
+         .dest = (void *)&script_path,
+         .descript = "Replay key matrix events from <path>, one \"<ms> <row> <col> <0|1>\" per line"},
+        ARG_TABLE_ENDMARKER,
+    };
+
+    native_add_command_line_opts(options);
+}
+
+NATIVE_TASK(key_matrix_sim_add_options, PRE_BOOT_1, 1);
+NATIVE_TASK(key_script_load, PRE_BOOT_2, 1);
+
+static int key_matrix_sim_init(void) {
+    gpio_sim_set_output_hook(key_matrix_sim_output_changed, NULL);
+    key_script_schedule_next();
+
+    LOG_INF("Emulated %dx%d key matrix, %d scripted events", ROWS, COLS, (int)script_len);
+    return 0;
+}
+
+SYS_INIT(key_matrix_sim_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_led_strip_sim
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/led_strip.h>
+
+#include <deemen17/sim.h>
+
+struct led_strip_sim_config {
+    size_t chain_length;
+};
+
+// One trace line per frame: its length and how many of its pixels are lit
+static int led_strip_sim_update_rgb(const struct device *dev, struct led_rgb *pixels,
+                                    size_t num_pixels) {
+    const struct led_strip_sim_config *config = dev->config;
+    size_t len = MIN(num_pixels, config->chain_length);
+    size_t lit = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        if (pixels[i].r || pixels[i].g || pixels[i].b) {
+            lit++;
+        }
+    }
+
+    sim_trace_emit(dev->name, "frame len=%u lit=%u", (unsigned int)len, (unsigned int)lit);
+    return 0;
+}
+
+static int led_strip_sim_update_channels(const struct device *dev, uint8_t *channels,
+                                         size_t num_channels) {
+    sim_trace_emit(dev->name, "channels len=%u", (unsigned int)num_channels);
+    return 0;
+}
+
+static const struct led_strip_driver_api led_strip_sim_api = {
+    .update_rgb = led_strip_sim_update_rgb,
+    .update_channels = led_strip_sim_update_channels,
+};
+
+#define LED_STRIP_SIM_INST(n)                                                                      \
+    static const struct led_strip_sim_config led_strip_sim_config_##n = {                          \
+        .chain_length = DT_INST_PROP(n, chain_length),                                             \
+    };                                                                                             \
+    DEVICE_DT_INST_DEFINE(n, NULL, NULL, NULL, &led_strip_sim_config_##n, POST_KERNEL,             \
+                          CONFIG_LED_STRIP_INIT_PRIORITY, &led_strip_sim_api);
+
+DT_INST_FOREACH_STATUS_OKAY(LED_STRIP_SIM_INST)
@@ -0,0 +1,27 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Every position event ZMK raises goes to the trace next to the key_matrix switch
+// changes, so switch-to-event latency can be read off a single file
+
+#include <zephyr/kernel.h>
+
+#include <zmk/event_manager.h>
+#include <zmk/events/position_state_changed.h>
+
+#include <deemen17/listener_profile.h>
+#include <deemen17/sim.h>
+
+static int position_trace_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+
+    sim_trace_emit("position", "pos=%u pressed=%u", ev->position, ev->state);
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_position_trace, position_trace_listener);
+ZMK_SUBSCRIPTION(deemen17_position_trace, zmk_position_state_changed);
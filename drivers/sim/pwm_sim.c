@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_pwm_sim
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/pwm.h>
+#include <zephyr/kernel.h>
+
+#include <deemen17/pwm_seq.h>
+#include <deemen17/pwm_share.h>
+#include <deemen17/sim.h>
+
+#define PWM_SIM_MAX_CHANNELS 8
+
+struct pwm_sim_config {
+    uint32_t clock_frequency;
+    uint8_t channels;
+    bool shared_period;
+};
+
+struct pwm_sim_channel {
+    uint32_t period_cycles;
+    uint32_t pulse_cycles;
+    pwm_flags_t flags;
+};
+
+struct pwm_sim_data {
+    const struct device *dev;
+    struct k_spinlock lock;
+    struct pwm_sim_channel channels[PWM_SIM_MAX_CHANNELS]; // Last traced output
+
+    // With shared-period, what each channel asked for
+    struct pwm_share_channel requested[PWM_SIM_MAX_CHANNELS];
+    struct pwm_share share;
+
+    // Sequence playback is recorded to the trace and completes after its total length
+    struct k_timer seq_timer;
+    uint32_t seq_channel;
+    bool seq_active;
+    pwm_seq_done_t seq_done;
+    void *seq_user_data;
+};
+
+static uint64_t cycles_to_ns(const struct pwm_sim_config *config, uint32_t cycles) {
+    return (uint64_t)cycles * NSEC_PER_SEC / config->clock_frequency;
+}
+
+static uint32_t ns_to_cycles(const struct pwm_sim_config *config, uint32_t ns) {
+    return (uint32_t)((uint64_t)ns * config->clock_frequency / NSEC_PER_SEC);
+}
+
+// Trace a channel's output if it changed
+static void pwm_sim_output(const struct device *dev, uint32_t channel, uint32_t period_cycles,
+                           uint32_t pulse_cycles, pwm_flags_t flags) {
+    const struct pwm_sim_config *config = dev->config;
+    struct pwm_sim_channel *ch = &((struct pwm_sim_data *)dev->data)->channels[channel];
+
+    if (ch->period_cycles == period_cycles && ch->pulse_cycles == pulse_cycles &&
+        ch->flags == flags) {
+        return;
+    }
+
+    ch->period_cycles = period_cycles;
+    ch->pulse_cycles = pulse_cycles;
+    ch->flags = flags;
+
+    sim_trace_emit(dev->name, "ch=%u period_ns=%llu pulse_ns=%llu inverted=%u", channel,
+                   cycles_to_ns(config, period_cycles), cycles_to_ns(config, pulse_cycles),
+                   (flags & PWM_POLARITY_INVERTED) ? 1 : 0);
+}
+
+// Shared period: every active channel runs at the owner's period with its own duty
+static void pwm_sim_output_shared(const struct device *dev) {
+    const struct pwm_sim_config *config = dev->config;
+    struct pwm_sim_data *data = dev->data;
+    uint32_t period = data->share.period_cycles;
+
+    for (uint32_t ch = 0; ch < config->channels; ch++) {
+        const struct pwm_share_channel *req = &data->requested[ch];
+
+        if (pwm_share_active(req)) {
+            pwm_sim_output(dev, ch, period, pwm_share_pulse(&data->share, ch, period),
+                           req->flags);
+        } else {
+            pwm_sim_output(dev, ch, req->period_cycles, 0, req->flags);
+        }
+    }
+}
+
+// Called with the lock held
+static void pwm_sim_seq_halt(const struct device *dev) {
+    struct pwm_sim_data *data = dev->data;
+
+    if (data->seq_active) {
+        k_timer_stop(&data->seq_timer);
+        data->seq_active = false;
+        data->seq_done = NULL;
+        sim_trace_emit(dev->name, "seq ch=%u stopped", data->seq_channel);
+    }
+}
+
+static int pwm_sim_set_cycles(const struct device *dev, uint32_t channel, uint32_t period_cycles,
+                              uint32_t pulse_cycles, pwm_flags_t flags) {
+    const struct pwm_sim_config *config = dev->config;
+    struct pwm_sim_data *data = dev->data;
+
+    if (channel >= config->channels) {
+        return -EINVAL;
+    }
+
+    if (pulse_cycles > period_cycles) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    if (!config->shared_period) {
+        pwm_sim_output(dev, channel, period_cycles, pulse_cycles, flags);
+    } else {
+        if (data->seq_active && data->seq_channel == channel) {
+            // Setting the sequence's own channel takes it over
+            pwm_sim_seq_halt(dev);
+        }
+
+        pwm_share_set(&data->share, channel, period_cycles, pulse_cycles, flags);
+
+        // A sequence holds the outputs, changes show once it hands back
+        if (!data->seq_active) {
+            pwm_sim_output_shared(dev);
+        }
+    }
+
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+static int pwm_sim_get_cycles_per_sec(const struct device *dev, uint32_t channel,
+                                      uint64_t *cycles) {
+    const struct pwm_sim_config *config = dev->config;
+
+    if (channel >= config->channels) {
+        return -EINVAL;
+    }
+
+    *cycles = config->clock_frequency;
+
+    return 0;
+}
+
+static void pwm_sim_seq_expired(struct k_timer *timer) {
+    struct pwm_sim_data *data = CONTAINER_OF(timer, struct pwm_sim_data, seq_timer);
+    const struct pwm_sim_config *config = data->dev->config;
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+    pwm_seq_done_t done = data->seq_done;
+    void *user_data = data->seq_user_data;
+
+    if (!data->seq_active) {
+        k_spin_unlock(&data->lock, key);
+        return;
+    }
+
+    data->seq_active = false;
+    data->seq_done = NULL;
+    sim_trace_emit(data->dev->name, "seq ch=%u done", data->seq_channel);
+    if (config->shared_period) {
+        pwm_sim_output_shared(data->dev);
+    }
+    k_spin_unlock(&data->lock, key);
+
+    if (done) {
+        done(data->dev, user_data);
+    }
+}
+
+static int pwm_sim_seq_stop(const struct device *dev) {
+    const struct pwm_sim_config *config = dev->config;
+    struct pwm_sim_data *data = dev->data;
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    if (data->seq_active) {
+        pwm_sim_seq_halt(dev);
+        if (config->shared_period) {
+            pwm_sim_output_shared(dev);
+        }
+    }
+
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+// With shared-period, the pulse every other active channel holds during a step
+static void pwm_sim_seq_trace_held(const struct device *dev, uint32_t channel, uint32_t step,
+                                   uint32_t period_ns) {
+    const struct pwm_sim_config *config = dev->config;
+    struct pwm_sim_data *data = dev->data;
+    uint32_t period_cycles = ns_to_cycles(config, period_ns);
+
+    for (uint32_t ch = 0; ch < config->channels; ch++) {
+        if (ch == channel || !pwm_share_active(&data->requested[ch])) {
+            continue;
+        }
+
+        sim_trace_emit(dev->name, "seq ch=%u step=%u hold ch=%u period_ns=%llu pulse_ns=%llu",
+                       channel, step, ch, cycles_to_ns(config, period_cycles),
+                       cycles_to_ns(config, pwm_share_pulse(&data->share, ch, period_cycles)));
+    }
+}
+
+static int pwm_sim_seq_play(const struct device *dev, uint32_t channel, pwm_flags_t flags,
+                            const struct pwm_seq_step *steps, size_t count, pwm_seq_done_t done,
+                            void *user_data) {
+    const struct pwm_sim_config *config = dev->config;
+    struct pwm_sim_data *data = dev->data;
+    uint64_t total_ns = 0;
+
+    if (channel >= config->channels || count == 0) {
+        return -EINVAL;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&data->lock);
+
+    pwm_sim_seq_halt(dev);
+
+    sim_trace_emit(dev->name, "seq ch=%u steps=%u inverted=%u", channel, (uint32_t)count,
+                   (flags & PWM_POLARITY_INVERTED) ? 1 : 0);
+    for (size_t i = 0; i < count; i++) {
+        sim_trace_emit(dev->name, "seq ch=%u step=%u period_ns=%u pulse_ns=%u periods=%u",
+                       channel, (uint32_t)i, steps[i].period_ns, steps[i].pulse_ns,
+                       steps[i].periods);
+        if (config->shared_period) {
+            pwm_sim_seq_trace_held(dev, channel, i, steps[i].period_ns);
+        }
+        total_ns += (uint64_t)steps[i].period_ns * steps[i].periods;
+    }
+
+    data->seq_channel = channel;
+    data->seq_active = true;
+    data->seq_done = done;
+    data->seq_user_data = user_data;
+    k_timer_start(&data->seq_timer, K_NSEC(total_ns), K_NO_WAIT);
+
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+static const struct pwm_seq_driver_api pwm_sim_api = {
+    .pwm =
+        {
+            .set_cycles = pwm_sim_set_cycles,
+            .get_cycles_per_sec = pwm_sim_get_cycles_per_sec,
+        },
+    .play = pwm_sim_seq_play,
+    .stop = pwm_sim_seq_stop,
+};
+
+static int pwm_sim_init(const struct device *dev) {
+    const struct pwm_sim_config *config = dev->config;
+    struct pwm_sim_data *data = dev->data;
+
+    data->dev = dev;
+    data->share = (struct pwm_share){
+        .channels = data->requested,
+        .channels_len = config->channels,
+    };
+    k_timer_init(&data->seq_timer, pwm_sim_seq_expired, NULL);
+
+    return 0;
+}
+
+#define PWM_SIM_INST(n)                                                                            \
+    BUILD_ASSERT(DT_INST_PROP(n, channels) <= PWM_SIM_MAX_CHANNELS,                                \
+                 "Too many emulated PWM channels");                                                \
+    static const struct pwm_sim_config pwm_sim_config_##n = {                                      \
+        .clock_frequency = DT_INST_PROP(n, clock_frequency),                                       \
+        .channels = DT_INST_PROP(n, channels),                                                     \
+        .shared_period = DT_INST_PROP(n, shared_period),                                           \
+    };                                                                                             \
+    static struct pwm_sim_data pwm_sim_data_##n;                                                   \
+    DEVICE_DT_INST_DEFINE(n, pwm_sim_init, NULL, &pwm_sim_data_##n, &pwm_sim_config_##n,          \
+                          POST_KERNEL, CONFIG_PWM_INIT_PRIORITY, &pwm_sim_api);
+
+DT_INST_FOREACH_STATUS_OKAY(PWM_SIM_INST)
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "sim_host_bottom.h"
+
+#define SIM_HOST_MAX_FILES 4
+
+static FILE *files[SIM_HOST_MAX_FILES];
+
+int sim_host_open(const char *path, int for_write) {
+    for (int i = 0; i < SIM_HOST_MAX_FILES; i++) {
+        if (files[i] != NULL) {
+            continue;
+        }
+
+        files[i] = fopen(path, for_write ? "w" : "r");
+        if (files[i] == NULL) {
+            return -1;
+        }
+
+        if (for_write) {
+            // Keep the trace usable even if the simulator is killed
+            setvbuf(files[i], NULL, _IOLBF, 0);
+        }
+        return i;
+    }
+
+    return -1;
+}
+
+void sim_host_write(int handle, const char *line) {
+    if (handle < 0 || handle >= SIM_HOST_MAX_FILES || files[handle] == NULL) {
+        return;
+    }
+
+    fputs(line, files[handle]);
+}
+
+int sim_host_read_line(int handle, char *buf, size_t len) {
+    if (handle < 0 || handle >= SIM_HOST_MAX_FILES || files[handle] == NULL) {
+        return -1;
+    }
+
+    if (fgets(buf, (int)len, files[handle]) == NULL) {
+        return -1;
+    }
+
+    return (int)strlen(buf);
+}
+
+void sim_host_close(int handle) {
+    if (handle < 0 || handle >= SIM_HOST_MAX_FILES || files[handle] == NULL) {
+        return;
+    }
+
+    fclose(files[handle]);
+    files[handle] = NULL;
+}
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Host libc file access for native_sim. Only plain C types cross this boundary.
+
+#include <stddef.h>
+
+int sim_host_open(const char *path, int for_write);
+void sim_host_write(int handle, const char *line);
+int sim_host_read_line(int handle, char *buf, size_t len);
+void sim_host_close(int handle);
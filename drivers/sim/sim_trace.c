@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <stdarg.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include <cmdline.h>
+#include <posix_native_task.h>
+
+#include <deemen17/sim.h>
+
+#include "sim_host_bottom.h"
+
+#define SIM_TRACE_LINE_MAX 160
+
+static char *trace_path;
+static int trace_handle = -1;
+static struct k_spinlock trace_lock;
+
+void sim_trace_emit(const char *source, const char *fmt, ...) {
+    char line[SIM_TRACE_LINE_MAX];
+    va_list args;
+    int len;
+
+    if (trace_handle < 0) {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&trace_lock);
+
+    len = snprintk(line, sizeof(line), "%llu %s ",
+                   (unsigned long long)k_ticks_to_us_floor64(k_uptime_ticks()), source);
+    if (len < (int)sizeof(line)) {
+        va_start(args, fmt);
+        len += vsnprintk(line + len, sizeof(line) - len, fmt, args);
+        va_end(args);
+    }
+
+    // Truncate overlong messages but always keep the line terminator
+    len = MIN(len, (int)sizeof(line) - 2);
+    line[len++] = '\n';
+    line[len] = '\0';
+
+    sim_host_write(trace_handle, line);
+
+    k_spin_unlock(&trace_lock, key);
+}
+
+static void sim_trace_add_options(void) {
+    static struct args_struct_t options[] = {
+        {.option = "trace-file",
+         .name = "path",
+         .type = 's',
+         .dest = (void *)&trace_path,
+         .descript = "Write a timestamped trace of emulated GPIO and PWM output changes"},
+        ARG_TABLE_ENDMARKER,
+    };
+
+    native_add_command_line_opts(options);
+}
+
+static void sim_trace_open(void) {
+    if (trace_path == NULL) {
+        return;
+    }
+
+    trace_handle = sim_host_open(trace_path, 1);
+    if (trace_handle < 0) {
+        printk("sim_trace: unable to open %s\n", trace_path);
+    }
+}
+
+static void sim_trace_close(void) {
+    sim_host_close(trace_handle);
+    trace_handle = -1;
+}
+
+NATIVE_TASK(sim_trace_add_options, PRE_BOOT_1, 1);
+NATIVE_TASK(sim_trace_open, PRE_BOOT_2, 1);
+NATIVE_TASK(sim_trace_close, ON_EXIT, 1);
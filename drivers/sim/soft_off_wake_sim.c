@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// With --wake-from-soft-off the boot reads as a wake from soft-off, so the resume
+// path can be run on the sim. Otherwise every boot reads as a power-on reset.
+
+#include <zephyr/drivers/hwinfo.h>
+#include <zephyr/init.h>
+
+#include <cmdline.h>
+#include <posix_native_task.h>
+
+static bool wake_from_soft_off;
+
+#if IS_ENABLED(CONFIG_HWINFO_NRF)
+#include <soc.h>
+
+// The nRF driver reads RESETREAS from the simulated POWER peripheral, set the bit a
+// wake from System OFF leaves there before anything reads it
+static int soft_off_wake_sim_init(void) {
+    if (wake_from_soft_off) {
+        NRF_POWER->RESETREAS = POWER_RESETREAS_OFF_Msk;
+    }
+
+    return 0;
+}
+
+SYS_INIT(soft_off_wake_sim_init, PRE_KERNEL_1, 0);
+#else
+static bool reset_cause_cleared;
+
+int z_impl_hwinfo_get_reset_cause(uint32_t *cause) {
+    if (reset_cause_cleared) {
+        *cause = 0;
+    } else {
+        *cause = wake_from_soft_off ? RESET_LOW_POWER_WAKE : RESET_POR;
+    }
+
+    return 0;
+}
+
+int z_impl_hwinfo_clear_reset_cause(void) {
+    reset_cause_cleared = true;
+    return 0;
+}
+
+int z_impl_hwinfo_get_supported_reset_cause(uint32_t *supported) {
+    *supported = RESET_POR | RESET_LOW_POWER_WAKE;
+    return 0;
+}
+#endif
+
+static void soft_off_wake_sim_add_options(void) {
+    static struct args_struct_t options[] = {
+        {.is_switch = true,
+         .option = "wake-from-soft-off",
+         .type = 'b',
+         .dest = (void *)&wake_from_soft_off,
+         .descript = "Boot as a wake from soft-off"},
+        ARG_TABLE_ENDMARKER,
+    };
+
+    native_add_command_line_opts(options);
+}
+
+NATIVE_TASK(soft_off_wake_sim_add_options, PRE_BOOT_1, 1);
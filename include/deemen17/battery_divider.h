@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/drivers/sensor.h>
+
+// Set on SENSOR_CHAN_GAUGE_VOLTAGE: skip sampling for the next val1 milliseconds
+// while a load transition sags the battery, fetches keep serving the filtered value
+#define BATTERY_DIVIDER_ATTR_HOLD_OFF ((enum sensor_attribute)SENSOR_ATTR_PRIV_START)
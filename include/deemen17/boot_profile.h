@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/sys/util_macro.h>
+
+enum boot_stage {
+    BOOT_STAGE_PRE_KERNEL_DONE,
+    BOOT_STAGE_POST_KERNEL,
+    BOOT_STAGE_APPLICATION,
+    BOOT_STAGE_APPLICATION_DONE,
+    BOOT_STAGE_BUZZER_READY,
+    BOOT_STAGE_FIRST_SCAN,
+    BOOT_STAGE_FIRST_ADVERTISING,
+    BOOT_STAGE_STARTUP_CHIME,
+    BOOT_STAGE_FIRST_KEY,
+    BOOT_STAGE_FIRST_REPORT,
+    BOOT_STAGE_COUNT,
+};
+
+#if IS_ENABLED(CONFIG_DEEMEN17_BOOT_PROFILE)
+// Record the uptime a boot stage was reached; only the first call per stage counts
+void boot_profile_mark(enum boot_stage stage);
+#else
+static inline void boot_profile_mark(enum boot_stage stage) {}
+#endif
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/sys/util_macro.h>
+#include <zmk/endpoints_types.h>
+#include <zmk/event_manager.h>
+
+// Fields that differ between a snapshot and the one before it
+enum conn_state_change {
+    CONN_STATE_CHANGED_ENDPOINT = BIT(0),  // Selected transport, or its BLE profile
+    CONN_STATE_CHANGED_PROFILE = BIT(1),   // Active BLE profile
+    CONN_STATE_CHANGED_CONNECTED = BIT(2), // Active profile connected or disconnected
+    CONN_STATE_CHANGED_BONDED = BIT(3),    // Active profile bonded or cleared
+};
+
+// Connectivity at one point in time. A published snapshot is never modified, the
+// next one replaces it with a higher generation.
+struct conn_state {
+    uint32_t generation;
+    struct zmk_endpoint_instance endpoint; // Selected endpoint
+    uint8_t active_profile;                // Always 0 without BLE
+    bool active_profile_connected;
+    bool active_profile_bonded;
+};
+
+// Copy of the latest snapshot. Before the first one exists it is taken here, which
+// may block, so call from a thread.
+void conn_state_get(struct conn_state *state);
+
+// Raised once per new snapshot, after it has been published
+struct deemen17_conn_state_changed {
+    struct conn_state state;
+    uint8_t changes; // conn_state_change bits
+};
+
+ZMK_EVENT_DECLARE(deemen17_conn_state_changed);
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/device.h>
+#include <zephyr/sys/util_macro.h>
+
+// Loads that report their own on/off transitions; the others are sampled
+enum energy_source {
+    ENERGY_SOURCE_BUZZER,
+};
+
+#if IS_ENABLED(CONFIG_DEEMEN17_ENERGY)
+// An LED was switched on or off; LEDs without an energy model channel are ignored
+void energy_led_set(const struct device *dev, uint32_t led, bool on);
+
+// A reporting load started or stopped drawing current
+void energy_source_set(enum energy_source source, bool on);
+#else
+static inline void energy_led_set(const struct device *dev, uint32_t led, bool on) {}
+static inline void energy_source_set(enum energy_source source, bool on) {}
+#endif
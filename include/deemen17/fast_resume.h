@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <deemen17/feedback.h>
+
+#if IS_ENABLED(CONFIG_DEEMEN17_FAST_RESUME)
+// Schedule a feedback job, or hold it until the first HID report has been sent
+// when the board is resuming from soft-off. Call from init.
+void fast_resume_defer(struct feedback_job *job, uint32_t delay_ms, uint32_t slack_ms);
+
+// Called by the HID report hook after every report
+void fast_resume_report_sent(void);
+#else
+static inline void fast_resume_defer(struct feedback_job *job, uint32_t delay_ms,
+                                     uint32_t slack_ms) {
+    feedback_job_schedule(job, delay_ms, slack_ms);
+}
+
+static inline void fast_resume_report_sent(void) {}
+#endif
+
+#if IS_ENABLED(CONFIG_DEEMEN17_FAST_RESUME) && IS_ENABLED(CONFIG_ZMK_BLE)
+struct bt_le_adv_param;
+struct bt_data;
+
+// Called by the advertising hook in place of bt_le_adv_start()
+int fast_resume_adv_start(const struct bt_le_adv_param *param, const struct bt_data *ad,
+                          size_t ad_len, const struct bt_data *sd, size_t sd_len);
+
+// Called by the advertising hook after bt_le_adv_stop()
+void fast_resume_adv_stopped(void);
+#endif
@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/sys/slist.h>
+
+struct feedback_job;
+
+typedef void (*feedback_job_handler_t)(struct feedback_job *job);
+
+// Deferred buzzer, LED and indicator work. A job becomes runnable at its release
+// time and runnable jobs run one at a time, earliest deadline first.
+struct feedback_job {
+    sys_snode_t node;
+    feedback_job_handler_t handler;
+    int64_t release;  // Uptime ticks
+    int64_t deadline; // Uptime ticks
+    bool queued;
+};
+
+#define FEEDBACK_JOB_INITIALIZER(_handler) {.handler = (_handler)}
+
+#define FEEDBACK_JOB_DEFINE(name, _handler)                                                        \
+    struct feedback_job name = FEEDBACK_JOB_INITIALIZER(_handler)
+
+void feedback_job_init(struct feedback_job *job, feedback_job_handler_t handler);
+
+// Run the job delay_ms from now, and within slack_ms after that when the executor is
+// busy. Replaces the pending release time if the job is already queued. ISR safe.
+void feedback_job_schedule(struct feedback_job *job, uint32_t delay_ms, uint32_t slack_ms);
+
+// Remove a queued job; returns false if it was not queued. A running job is not stopped.
+bool feedback_job_cancel(struct feedback_job *job);
+
+bool feedback_job_is_queued(const struct feedback_job *job);
@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/endpoints_types.h>
+
+// Called once a HID report has been handed to the transport
+void latency_trace_report_sent(enum zmk_transport transport);
@@ -0,0 +1,29 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zmk/event_manager.h>
+
+#if IS_ENABLED(CONFIG_DEEMEN17_LISTENER_PROFILE)
+#include <zephyr/timing/timing.h>
+
+void listener_profile_record(const char *listener, const zmk_event_t *eh, timing_t start,
+                             timing_t end);
+
+// ZMK_LISTENER with every call of the callback timed, per event type
+#define DEEMEN17_LISTENER(mod, cb)                                                                 \
+    static int mod##_profiled(const zmk_event_t *eh) {                                             \
+        timing_t start = timing_counter_get();                                                     \
+        int ret = cb(eh);                                                                          \
+                                                                                                   \
+        listener_profile_record(#mod, eh, start, timing_counter_get());                            \
+        return ret;                                                                                \
+    }                                                                                              \
+    ZMK_LISTENER(mod, mod##_profiled)
+#else
+#define DEEMEN17_LISTENER(mod, cb) ZMK_LISTENER(mod, cb)
+#endif
@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/drivers/sensor.h>
+
+// Set on SENSOR_CHAN_GAUGE_STATE_OF_CHARGE: val1 is non-zero while the board runs
+// from external power, when the state of charge is sampled at the fastest rate
+#define MAX17048_ATTR_EXTERNAL_POWER ((enum sensor_attribute)SENSOR_ATTR_PRIV_START)
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <errno.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/pwm.h>
+
+// One step of a PWM sequence: a waveform held for a number of its own periods
+struct pwm_seq_step {
+    uint32_t period_ns;
+    uint32_t pulse_ns; // 0 holds the output inactive
+    uint32_t periods;
+};
+
+// Called from interrupt context once the last step has been played
+typedef void (*pwm_seq_done_t)(const struct device *dev, void *user_data);
+
+// PWM controllers that can play a whole sequence without CPU involvement. The
+// regular PWM API comes first so these devices also work with pwm_set_dt().
+struct pwm_seq_driver_api {
+    struct pwm_driver_api pwm;
+    int (*play)(const struct device *dev, uint32_t channel, pwm_flags_t flags,
+                const struct pwm_seq_step *steps, size_t count, pwm_seq_done_t done,
+                void *user_data);
+    int (*stop)(const struct device *dev);
+};
+
+// Start playing steps on a channel, replacing any sequence in progress. The
+// steps are copied, the caller's buffer may be reused once this returns.
+// Returns -ENOMEM if the sequence does not fit the controller's buffer, and
+// -EINVAL for a step the controller cannot hold for exactly its periods.
+static inline int pwm_seq_play(const struct device *dev, uint32_t channel, pwm_flags_t flags,
+                               const struct pwm_seq_step *steps, size_t count,
+                               pwm_seq_done_t done, void *user_data) {
+    const struct pwm_seq_driver_api *api = dev->api;
+
+    return api->play(dev, channel, flags, steps, count, done, user_data);
+}
+
+// Stop the sequence in progress without calling its done callback
+static inline int pwm_seq_stop(const struct device *dev) {
+    const struct pwm_seq_driver_api *api = dev->api;
+
+    return api->stop(dev);
+}
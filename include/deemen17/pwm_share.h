@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/drivers/pwm.h>
+#include <zephyr/sys/util.h>
+
+// What a user last asked of a channel with pwm_set_cycles()
+struct pwm_share_channel {
+    uint32_t period_cycles;
+    uint32_t pulse_cycles; // 0 when the channel is off
+    pwm_flags_t flags;
+};
+
+// Channels of a PWM instance that has one period for all of them. The channel
+// set last owns the period, the others keep their duty cycle at whatever period
+// is current. Not thread safe, callers hold their driver's lock.
+struct pwm_share {
+    struct pwm_share_channel *channels;
+    uint8_t channels_len;
+    uint32_t period_cycles;  // 0 while every channel is off
+    uint32_t updates;        // pwm_share_set() calls
+    uint32_t period_changes; // Updates that moved the shared period
+};
+
+#define PWM_SHARE_INITIALIZER(_channels)                                                           \
+    {.channels = (_channels), .channels_len = ARRAY_SIZE(_channels)}
+
+static inline bool pwm_share_active(const struct pwm_share_channel *ch) {
+    return ch->period_cycles != 0 && ch->pulse_cycles != 0;
+}
+
+// Record a channel's waveform and pick the shared period for it. Returns the new
+// shared period, 0 when every channel is off.
+uint32_t pwm_share_set(struct pwm_share *share, uint32_t channel, uint32_t period_cycles,
+                       uint32_t pulse_cycles, pwm_flags_t flags);
+
+// A channel's pulse at another period, same duty cycle; 0 when the channel is off
+uint32_t pwm_share_pulse(const struct pwm_share *share, uint32_t channel, uint32_t period_cycles);
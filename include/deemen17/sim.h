@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <zephyr/device.h>
+#include <zephyr/drivers/gpio.h>
+
+// Append one "<uptime_us> <source> <message>" line to the trace file.
+// Does nothing unless the simulator was started with --trace-file=<path>.
+void sim_trace_emit(const char *source, const char *fmt, ...);
+
+// Called after any emulated GPIO port changes the level of one of its outputs
+typedef void (*gpio_sim_output_hook_t)(const struct device *port, gpio_port_pins_t changed,
+                                       void *user_data);
+
+void gpio_sim_set_output_hook(gpio_sim_output_hook_t hook, void *user_data);
+
+// Raw level currently driven on an output pin
+int gpio_sim_output_get(const struct device *port, gpio_pin_t pin);
+
+// Drive the raw level seen on an input pin, firing interrupts as configured
+int gpio_sim_input_set(const struct device *port, gpio_pin_t pin, int level);
+
+// Close or open the switch at a matrix position of the emulated key matrix
+int key_matrix_sim_set(uint8_t row, uint8_t col, bool pressed);
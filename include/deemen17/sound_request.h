@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/sys/atomic.h>
+
+#define SOUND_MAILBOX_MAX_CLASSES 8
+
+// Sound request mailbox: one slot per class, higher classes take priority. A newer
+// request of a class replaces the one still waiting (latest wins), and requests left
+// waiting longer than max_age_ms are dropped instead of played late.
+struct sound_mailbox {
+    atomic_t slots[SOUND_MAILBOX_MAX_CLASSES];
+    uint8_t classes;
+    uint16_t max_age_ms;
+    atomic_t posted;
+    atomic_t coalesced; // Posts that replaced a waiting request
+    atomic_t dropped;   // Requests that waited too long
+};
+
+#define SOUND_MAILBOX_INITIALIZER(_classes, _max_age_ms)                                           \
+    {.classes = (_classes), .max_age_ms = (_max_age_ms)}
+
+// Producer side: never blocks or allocates, safe from any context. Returns true if
+// a waiting request of the same class was replaced.
+bool sound_mailbox_post(struct sound_mailbox *mb, uint8_t sound_class, uint8_t arg,
+                        uint32_t now_ms);
+
+// Consumer side: takes the highest priority request of min_class or above, dropping
+// stale requests on the way. Returns false when nothing may start now; requests below
+// min_class keep waiting.
+bool sound_mailbox_take(struct sound_mailbox *mb, uint8_t min_class, uint32_t now_ms,
+                        uint8_t *sound_class, uint8_t *arg);
+
+// Per-class token bucket: up to burst sounds back to back, then one more per refill
+// period. burst 0 means no limit.
+struct sound_limit {
+    uint8_t burst;
+    uint16_t refill_ms;
+};
+
+struct sound_bucket {
+    uint32_t stamp; // Time the tokens were last brought up to date
+    uint8_t tokens;
+    uint32_t dropped;
+};
+
+// Fill a bucket, so the first sounds after boot are not dropped
+void sound_bucket_init(struct sound_bucket *bucket, const struct sound_limit *limit,
+                       uint32_t now_ms);
+
+// Takes a token, or returns false and counts a drop when the bucket is empty. Constant
+// time: refills are counted from the elapsed time, not ticked in.
+bool sound_bucket_take(struct sound_bucket *bucket, const struct sound_limit *limit,
+                       uint32_t now_ms);
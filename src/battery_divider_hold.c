@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/sensor.h>
+
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+
+#include <deemen17/battery_divider.h>
+#include <deemen17/listener_profile.h>
+
+#define BATTERY_DIVIDER_NODE DT_INST(0, deemen17_battery_voltage_divider)
+
+// Underglow and external power switch with the activity state; keep the divider from
+// sampling the battery while it recovers from the load step
+static int battery_divider_hold_listener(const zmk_event_t *eh) {
+    struct sensor_value hold_off = {.val1 = CONFIG_DEEMEN17_BATTERY_DIVIDER_HOLD_OFF_MS};
+
+    sensor_attr_set(DEVICE_DT_GET(BATTERY_DIVIDER_NODE), SENSOR_CHAN_GAUGE_VOLTAGE,
+                    BATTERY_DIVIDER_ATTR_HOLD_OFF, &hold_off);
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_battery_divider_hold, battery_divider_hold_listener);
+ZMK_SUBSCRIPTION(deemen17_battery_divider_hold, zmk_activity_state_changed);
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Linked with -Wl,--wrap=bt_le_adv_start and --wrap=bt_le_adv_stop, every
+// advertising start and stop ZMK makes passes through here.
+
+#include <zephyr/kernel.h>
+#include <zephyr/bluetooth/bluetooth.h>
+
+#include <deemen17/boot_profile.h>
+#include <deemen17/fast_resume.h>
+
+int __real_bt_le_adv_start(const struct bt_le_adv_param *param, const struct bt_data *ad,
+                           size_t ad_len, const struct bt_data *sd, size_t sd_len);
+int __real_bt_le_adv_stop(void);
+
+int __wrap_bt_le_adv_start(const struct bt_le_adv_param *param, const struct bt_data *ad,
+                           size_t ad_len, const struct bt_data *sd, size_t sd_len) {
+#if IS_ENABLED(CONFIG_DEEMEN17_FAST_RESUME) && IS_ENABLED(CONFIG_ZMK_BLE)
+    int ret = fast_resume_adv_start(param, ad, ad_len, sd, sd_len);
+#else
+    int ret = __real_bt_le_adv_start(param, ad, ad_len, sd, sd_len);
+#endif
+
+    if (ret == 0) {
+        boot_profile_mark(BOOT_STAGE_FIRST_ADVERTISING);
+    }
+
+    return ret;
+}
+
+int __wrap_bt_le_adv_stop(void) {
+    int ret = __real_bt_le_adv_stop();
+
+#if IS_ENABLED(CONFIG_DEEMEN17_FAST_RESUME) && IS_ENABLED(CONFIG_ZMK_BLE)
+    fast_resume_adv_stopped();
+#endif
+
+    return ret;
+}
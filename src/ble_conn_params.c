@@ -0,0 +1,318 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/ble.h>
+#include <zmk/endpoints.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/position_state_changed.h>
+
+#include <deemen17/listener_profile.h>
+
+// A central that ignores a request never answers; give up after the LL procedure timeout
+#define CONN_PARAM_REQUEST_TIMEOUT_MS 40000
+
+enum conn_phase {
+    CONN_PHASE_ACTIVE,  // Typing: shortest interval, no peripheral latency
+    CONN_PHASE_RELAXED, // Quiet: longer interval, events skipped while there is nothing to send
+    CONN_PHASE_COUNT,
+};
+
+BUILD_ASSERT(CONFIG_DEEMEN17_BLE_CONN_TIMEOUT * 4 >
+                 (1 + CONFIG_DEEMEN17_BLE_CONN_RELAXED_LATENCY) *
+                     CONFIG_DEEMEN17_BLE_CONN_RELAXED_INTERVAL,
+             "Supervision timeout too short for the relaxed interval and latency");
+
+static const char *const phase_names[CONN_PHASE_COUNT] = {"active", "relaxed"};
+
+static const struct bt_le_conn_param phase_params[CONN_PHASE_COUNT] = {
+    [CONN_PHASE_ACTIVE] = BT_LE_CONN_PARAM_INIT(CONFIG_DEEMEN17_BLE_CONN_ACTIVE_INTERVAL,
+                                                CONFIG_DEEMEN17_BLE_CONN_ACTIVE_INTERVAL, 0,
+                                                CONFIG_DEEMEN17_BLE_CONN_TIMEOUT),
+    [CONN_PHASE_RELAXED] = BT_LE_CONN_PARAM_INIT(CONFIG_DEEMEN17_BLE_CONN_RELAXED_INTERVAL,
+                                                 CONFIG_DEEMEN17_BLE_CONN_RELAXED_INTERVAL,
+                                                 CONFIG_DEEMEN17_BLE_CONN_RELAXED_LATENCY,
+                                                 CONFIG_DEEMEN17_BLE_CONN_TIMEOUT),
+};
+
+struct conn_params_stats {
+    uint64_t phase_ms[CONN_PHASE_COUNT]; // Time spent with each phase's parameters applied
+    uint32_t requests[CONN_PHASE_COUNT];
+    uint32_t accepted[CONN_PHASE_COUNT];
+    uint32_t rejected;       // Requests the central answered otherwise, or never
+    uint32_t accept_ms_max;  // Request to le_param_updated
+    uint64_t accept_ms_sum;
+    uint32_t relaxed_keys;   // Presses that arrived on relaxed parameters
+};
+
+static struct {
+    struct bt_conn *conn; // Managed connection, compared by identity only
+    enum conn_phase requested;
+    int64_t requested_at;
+    bool pending;
+
+    enum conn_phase applied;
+    int64_t applied_since;
+    bool connected;
+
+    struct conn_params_stats stats;
+} state;
+
+static struct k_spinlock lock;
+
+// The connection ZMK sends reports over, or NULL; unref when done
+static struct bt_conn *active_conn(void) {
+    return bt_conn_lookup_addr_le(BT_ID_DEFAULT, zmk_ble_active_profile_addr());
+}
+
+// Centrals often round the interval to one of their own, e.g. 15 ms for a 7.5 ms
+// request, but keep the peripheral latency asked for. Only latency tells the phases apart.
+static enum conn_phase phase_of(uint16_t latency) {
+    return latency == 0 ? CONN_PHASE_ACTIVE : CONN_PHASE_RELAXED;
+}
+
+// Called with the lock held
+static void phase_applied(enum conn_phase phase, int64_t now) {
+    if (state.connected) {
+        state.stats.phase_ms[state.applied] += now - state.applied_since;
+    }
+    state.applied = phase;
+    state.applied_since = now;
+    state.connected = true;
+}
+
+// Start managing a connection, e.g. after connecting or switching profiles
+static void conn_params_adopt(struct bt_conn *conn) {
+    struct bt_conn_info info;
+
+    if (bt_conn_get_info(conn, &info)) {
+        return;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    int64_t now = k_uptime_get();
+
+    if (state.connected) {
+        state.stats.phase_ms[state.applied] += now - state.applied_since;
+    }
+    state.conn = conn;
+    state.connected = false;
+    state.pending = false;
+    phase_applied(phase_of(info.le.latency), now);
+    k_spin_unlock(&lock, key);
+}
+
+static void conn_params_request(enum conn_phase phase) {
+    struct bt_conn *conn = active_conn();
+    k_spinlock_key_t key;
+    int64_t now = k_uptime_get();
+    int err;
+
+    if (!conn) {
+        return;
+    }
+
+    if (conn != state.conn) {
+        conn_params_adopt(conn);
+    }
+
+    key = k_spin_lock(&lock);
+    if (state.pending && now - state.requested_at > CONN_PARAM_REQUEST_TIMEOUT_MS) {
+        state.stats.rejected++;
+        state.pending = false;
+    }
+
+    if ((state.pending ? state.requested : state.applied) == phase) {
+        k_spin_unlock(&lock, key);
+        bt_conn_unref(conn);
+        return;
+    }
+
+    state.requested = phase;
+    state.requested_at = now;
+    state.pending = true;
+    state.stats.requests[phase]++;
+    k_spin_unlock(&lock, key);
+
+    err = bt_conn_le_param_update(conn, &phase_params[phase]);
+    if (err) {
+        LOG_WRN("Failed to request %s connection parameters (%d)", phase_names[phase], err);
+        key = k_spin_lock(&lock);
+        state.pending = false;
+        k_spin_unlock(&lock, key);
+    }
+
+    bt_conn_unref(conn);
+}
+
+static void active_work_cb(struct k_work *work) { conn_params_request(CONN_PHASE_ACTIVE); }
+
+static void relaxed_work_cb(struct k_work *work) { conn_params_request(CONN_PHASE_RELAXED); }
+
+static K_WORK_DEFINE(active_work, active_work_cb);
+static K_WORK_DELAYABLE_DEFINE(relaxed_work, relaxed_work_cb);
+
+static int conn_params_key_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+    bool relaxed;
+
+    if (!ev->state || zmk_endpoints_selected().transport != ZMK_TRANSPORT_BLE) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    relaxed = !state.connected || state.applied != CONN_PHASE_ACTIVE;
+    if (state.connected && relaxed) {
+        state.stats.relaxed_keys++;
+    }
+    k_spin_unlock(&lock, key);
+
+    if (relaxed) {
+        k_work_submit(&active_work);
+    }
+    k_work_reschedule(&relaxed_work, K_MSEC(CONFIG_DEEMEN17_BLE_CONN_QUIET_MS));
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_ble_conn_params, conn_params_key_listener);
+ZMK_SUBSCRIPTION(deemen17_ble_conn_params, zmk_position_state_changed);
+
+static void conn_params_connected(struct bt_conn *conn, uint8_t err) {
+    struct bt_conn *active = active_conn();
+
+    if (!active) {
+        return;
+    }
+
+    bt_conn_unref(active);
+    if (err || active != conn) {
+        return;
+    }
+
+    conn_params_adopt(conn);
+
+    // Relax the connection unless typing starts right away
+    k_work_reschedule(&relaxed_work, K_MSEC(CONFIG_DEEMEN17_BLE_CONN_QUIET_MS));
+}
+
+static void conn_params_disconnected(struct bt_conn *conn, uint8_t reason) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    if (conn != state.conn) {
+        k_spin_unlock(&lock, key);
+        return;
+    }
+
+    if (state.connected) {
+        state.stats.phase_ms[state.applied] += k_uptime_get() - state.applied_since;
+    }
+    state.conn = NULL;
+    state.connected = false;
+    state.pending = false;
+    k_spin_unlock(&lock, key);
+
+    k_work_cancel_delayable(&relaxed_work);
+}
+
+static void conn_params_updated(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+                                uint16_t timeout) {
+    enum conn_phase phase = phase_of(latency);
+    int64_t now = k_uptime_get();
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    if (conn != state.conn) {
+        k_spin_unlock(&lock, key);
+        return;
+    }
+
+    // The central's answer to the pending request; anything but the phase asked for
+    // means it picked other parameters, which are kept until the next request
+    if (state.pending && state.requested == phase) {
+        uint32_t accept_ms = (uint32_t)(now - state.requested_at);
+
+        state.stats.accepted[phase]++;
+        state.stats.accept_ms_sum += accept_ms;
+        state.stats.accept_ms_max = MAX(state.stats.accept_ms_max, accept_ms);
+        state.pending = false;
+    } else if (state.pending) {
+        state.stats.rejected++;
+        state.pending = false;
+    }
+    phase_applied(phase, now);
+    k_spin_unlock(&lock, key);
+
+    LOG_DBG("Connection interval %u.%02u ms, latency %u, timeout %u ms", interval * 5 / 4,
+            (interval * 125) % 100, latency, timeout * 10);
+}
+
+BT_CONN_CB_DEFINE(deemen17_conn_params_callbacks) = {
+    .connected = conn_params_connected,
+    .disconnected = conn_params_disconnected,
+    .le_param_updated = conn_params_updated,
+};
+
+#if IS_ENABLED(CONFIG_SHELL)
+static int cmd_connparams_show(const struct shell *sh, size_t argc, char **argv) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    struct conn_params_stats stats = state.stats;
+    enum conn_phase applied = state.applied;
+    bool connected = state.connected;
+
+    if (connected) {
+        stats.phase_ms[applied] += k_uptime_get() - state.applied_since;
+    }
+    k_spin_unlock(&lock, key);
+
+    uint32_t accepted = stats.accepted[CONN_PHASE_ACTIVE] + stats.accepted[CONN_PHASE_RELAXED];
+
+    shell_print(sh, "phase: %s", connected ? phase_names[applied] : "disconnected");
+    for (int p = 0; p < CONN_PHASE_COUNT; p++) {
+        shell_print(sh, "%s: %u s, %u requested, %u accepted", phase_names[p],
+                    (uint32_t)(stats.phase_ms[p] / MSEC_PER_SEC), stats.requests[p],
+                    stats.accepted[p]);
+    }
+    shell_print(sh, "rejected: %u", stats.rejected);
+    shell_print(sh, "accept time: mean %u ms, max %u ms",
+                accepted ? (uint32_t)(stats.accept_ms_sum / accepted) : 0, stats.accept_ms_max);
+    shell_print(sh, "presses on relaxed parameters: %u", stats.relaxed_keys);
+
+    return 0;
+}
+
+static int cmd_connparams_reset(const struct shell *sh, size_t argc, char **argv) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    memset(&state.stats, 0, sizeof(state.stats));
+    state.applied_since = k_uptime_get();
+    k_spin_unlock(&lock, key);
+
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_connparams,
+                               SHELL_CMD(show, NULL, "Print connection parameter counters",
+                                         cmd_connparams_show),
+                               SHELL_CMD(reset, NULL, "Clear connection parameter counters",
+                                         cmd_connparams_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(connparams, &sub_connparams, "Adaptive BLE connection parameters", NULL);
+#endif
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/events/position_state_changed.h>
+
+#include <deemen17/boot_profile.h>
+#include <deemen17/listener_profile.h>
+
+static const char *const stage_names[BOOT_STAGE_COUNT] = {
+    "pre_kernel_done", "post_kernel",       "application",   "application_done", "buzzer_ready",
+    "first_scan",      "first_advertising", "startup_chime", "first_key",        "first_report",
+};
+
+static int64_t stage_ticks[BOOT_STAGE_COUNT];
+static atomic_t stage_seen;
+
+void boot_profile_mark(enum boot_stage stage) {
+    if (atomic_test_and_set_bit(&stage_seen, stage)) {
+        return;
+    }
+
+    stage_ticks[stage] = k_uptime_ticks();
+}
+
+static void boot_profile_report(struct k_work *work) {
+    for (int s = 0; s < BOOT_STAGE_COUNT; s++) {
+        if (atomic_test_bit(&stage_seen, s)) {
+            LOG_INF("boot %s at %u us", stage_names[s],
+                    (uint32_t)k_ticks_to_us_floor64(stage_ticks[s]));
+        } else {
+            LOG_INF("boot %s not reached", stage_names[s]);
+        }
+    }
+}
+
+static K_WORK_DELAYABLE_DEFINE(report_work, boot_profile_report);
+
+static int boot_profile_key_listener(const zmk_event_t *eh) {
+    boot_profile_mark(BOOT_STAGE_FIRST_KEY);
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_boot_profile, boot_profile_key_listener);
+ZMK_SUBSCRIPTION(deemen17_boot_profile, zmk_position_state_changed);
+
+static int boot_mark_pre_kernel_done(void) {
+    boot_profile_mark(BOOT_STAGE_PRE_KERNEL_DONE);
+    return 0;
+}
+
+static int boot_mark_post_kernel(void) {
+    boot_profile_mark(BOOT_STAGE_POST_KERNEL);
+    return 0;
+}
+
+static int boot_mark_application(void) {
+    boot_profile_mark(BOOT_STAGE_APPLICATION);
+    return 0;
+}
+
+static int boot_mark_application_done(void) {
+    boot_profile_mark(BOOT_STAGE_APPLICATION_DONE);
+    k_work_schedule(&report_work, K_MSEC(CONFIG_DEEMEN17_BOOT_PROFILE_REPORT_DELAY_MS));
+    return 0;
+}
+
+// First and last slot of each init level bracket everything registered in between
+SYS_INIT(boot_mark_pre_kernel_done, PRE_KERNEL_2, 99);
+SYS_INIT(boot_mark_post_kernel, POST_KERNEL, 0);
+SYS_INIT(boot_mark_application, APPLICATION, 0);
+SYS_INIT(boot_mark_application_done, APPLICATION, 99);
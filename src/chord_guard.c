@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_chord_guard
+
+#include <zephyr/devicetree.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/behavior.h>
+#include <zmk/event_manager.h>
+#include <zmk/keymap.h>
+#include <zmk/events/position_state_changed.h>
+
+#include <deemen17/listener_profile.h>
+
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1,
+             "Exactly one deemen17,chord-guard node is supported");
+
+#define CHORD_MAX_KEYS 8
+
+struct chord_cfg {
+    uint32_t positions[CHORD_MAX_KEYS];
+    uint8_t count;
+    uint32_t hold_ms;
+    struct zmk_behavior_binding binding;
+};
+
+struct chord_state {
+    struct k_work_delayable hold_work;
+    uint8_t held; // One bit per member key
+};
+
+#define CHORD_CFG(child)                                                                           \
+    {                                                                                              \
+        .positions = DT_PROP(child, key_positions),                                                \
+        .count = DT_PROP_LEN(child, key_positions),                                                \
+        .hold_ms = DT_PROP(child, hold_ms),                                                        \
+        .binding = ZMK_KEYMAP_EXTRACT_BINDING(0, child),                                           \
+    },
+
+#define CHORD_CHECK(child)                                                                         \
+    BUILD_ASSERT(DT_PROP_LEN(child, key_positions) <= CHORD_MAX_KEYS,                              \
+                 "Chord " DT_NODE_PATH(child) " has too many key positions");
+
+DT_INST_FOREACH_CHILD_STATUS_OKAY(0, CHORD_CHECK)
+
+static const struct chord_cfg chords[] = {DT_INST_FOREACH_CHILD_STATUS_OKAY(0, CHORD_CFG)};
+
+static struct chord_state chord_states[ARRAY_SIZE(chords)];
+
+static inline uint8_t chord_all(const struct chord_cfg *cfg) { return BIT_MASK(cfg->count); }
+
+static void chord_hold_expired(struct k_work *work) {
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    struct chord_state *state = CONTAINER_OF(dwork, struct chord_state, hold_work);
+    int idx = state - chord_states;
+    const struct chord_cfg *cfg = &chords[idx];
+    struct zmk_behavior_binding_event event = {
+        .position = cfg->positions[0],
+        .timestamp = k_uptime_get(),
+#if IS_ENABLED(CONFIG_ZMK_SPLIT)
+        .source = ZMK_POSITION_STATE_CHANGE_SOURCE_LOCAL,
+#endif
+    };
+
+    // A member released while this was already due
+    if (state->held != chord_all(cfg)) {
+        return;
+    }
+
+    LOG_INF("Chord %d held for %u ms", idx, cfg->hold_ms);
+    zmk_behavior_invoke_binding(&cfg->binding, event, true);
+    zmk_behavior_invoke_binding(&cfg->binding, event, false);
+}
+
+// Only watches positions; the event always bubbles on to the keymap undelayed
+static int chord_guard_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+
+    for (int i = 0; i < ARRAY_SIZE(chords); i++) {
+        const struct chord_cfg *cfg = &chords[i];
+        struct chord_state *state = &chord_states[i];
+
+        for (int j = 0; j < cfg->count; j++) {
+            if (cfg->positions[j] != ev->position) {
+                continue;
+            }
+
+            if (ev->state) {
+                state->held |= BIT(j);
+                if (state->held == chord_all(cfg)) {
+                    k_work_reschedule(&state->hold_work, K_MSEC(cfg->hold_ms));
+                }
+            } else {
+                if (state->held == chord_all(cfg)) {
+                    k_work_cancel_delayable(&state->hold_work);
+                }
+                state->held &= ~BIT(j);
+            }
+            break;
+        }
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_chord_guard, chord_guard_listener);
+ZMK_SUBSCRIPTION(deemen17_chord_guard, zmk_position_state_changed);
+
+static int chord_guard_init(void) {
+    for (int i = 0; i < ARRAY_SIZE(chord_states); i++) {
+        k_work_init_delayable(&chord_states[i].hold_work, chord_hold_expired);
+    }
+
+    return 0;
+}
+
+SYS_INIT(chord_guard_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// ZMK and the BLE stack are asked for the connection state once per endpoint or
+// profile event; indicators and feedback get the result as a snapshot.
+
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/endpoints.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/endpoint_changed.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+#include <zmk/ble.h>
+#include <zmk/events/ble_active_profile_changed.h>
+#endif
+
+#include <deemen17/conn_state.h>
+#include <deemen17/listener_profile.h>
+
+ZMK_EVENT_IMPL(deemen17_conn_state_changed);
+
+static struct conn_state current; // Generation 0 until the first snapshot
+static struct k_spinlock lock;      // Guards current for readers
+static K_MUTEX_DEFINE(update_lock); // Serialises query, diff and publish
+
+static struct {
+    uint32_t updates;   // Source events handled
+    uint32_t published; // Snapshots that changed something
+} stats;
+
+static struct conn_state conn_state_query(void) {
+    struct conn_state state = {
+        .endpoint = zmk_endpoints_selected(),
+    };
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    state.active_profile = zmk_ble_active_profile_index();
+    state.active_profile_connected = zmk_ble_active_profile_is_connected();
+    state.active_profile_bonded = !zmk_ble_active_profile_is_open();
+#endif
+
+    return state;
+}
+
+static uint8_t conn_state_diff(const struct conn_state *a, const struct conn_state *b) {
+    uint8_t changes = 0;
+
+    if (a->endpoint.transport != b->endpoint.transport ||
+        (a->endpoint.transport == ZMK_TRANSPORT_BLE &&
+         a->endpoint.ble.profile_index != b->endpoint.ble.profile_index)) {
+        changes |= CONN_STATE_CHANGED_ENDPOINT;
+    }
+    if (a->active_profile != b->active_profile) {
+        changes |= CONN_STATE_CHANGED_PROFILE;
+    }
+    if (a->active_profile_connected != b->active_profile_connected) {
+        changes |= CONN_STATE_CHANGED_CONNECTED;
+    }
+    if (a->active_profile_bonded != b->active_profile_bonded) {
+        changes |= CONN_STATE_CHANGED_BONDED;
+    }
+
+    return changes;
+}
+
+// Publishes a new snapshot when anything changed and returns what did. The first
+// snapshot has nothing to compare against and reports no changes. The query calls
+// into ZMK and the BLE stack, so it cannot run under the spinlock; the mutex keeps
+// a slower update from publishing an older query over a newer one.
+static uint8_t conn_state_update(struct conn_state *published) {
+    struct conn_state state;
+    k_spinlock_key_t key;
+    uint8_t changes;
+
+    k_mutex_lock(&update_lock, K_FOREVER);
+
+    state = conn_state_query();
+    changes = current.generation ? conn_state_diff(&current, &state) : 0;
+
+    key = k_spin_lock(&lock);
+    stats.updates++;
+    if (!current.generation || changes) {
+        state.generation = current.generation + 1;
+        current = state;
+        stats.published++;
+    }
+    *published = current;
+    k_spin_unlock(&lock, key);
+
+    k_mutex_unlock(&update_lock);
+
+    return changes;
+}
+
+void conn_state_get(struct conn_state *state) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    *state = current;
+    k_spin_unlock(&lock, key);
+
+    if (!state->generation) {
+        conn_state_update(state);
+    }
+}
+
+static int conn_state_listener(const zmk_event_t *eh) {
+    struct conn_state state;
+    uint8_t changes = conn_state_update(&state);
+
+    if (changes) {
+        raise_deemen17_conn_state_changed((struct deemen17_conn_state_changed){
+            .state = state,
+            .changes = changes,
+        });
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+// Profile changes and active profile (dis)connects both raise the profile event
+DEEMEN17_LISTENER(deemen17_conn_state, conn_state_listener);
+ZMK_SUBSCRIPTION(deemen17_conn_state, zmk_endpoint_changed);
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+ZMK_SUBSCRIPTION(deemen17_conn_state, zmk_ble_active_profile_changed);
+#endif
+
+#if IS_ENABLED(CONFIG_SHELL)
+static int cmd_connstate(const struct shell *sh, size_t argc, char **argv) {
+    struct conn_state state;
+
+    conn_state_get(&state);
+
+    shell_print(sh, "generation: %u, updates: %u, published: %u", state.generation, stats.updates,
+                stats.published);
+    shell_print(sh, "endpoint: %s", state.endpoint.transport == ZMK_TRANSPORT_BLE ? "BLE" : "USB");
+    shell_print(sh, "profile %u: %s, %s", state.active_profile,
+                state.active_profile_connected ? "connected" : "not connected",
+                state.active_profile_bonded ? "bonded" : "open");
+
+    return 0;
+}
+
+SHELL_CMD_REGISTER(connstate, NULL, "Print the shared connectivity state", cmd_connstate);
+#endif
+
+static int conn_state_init(void) {
+    struct conn_state state;
+
+    // Baseline for the first events; later snapshots only come from events
+    conn_state_update(&state);
+
+    return 0;
+}
+
+SYS_INIT(conn_state_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_energy_model
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/activity.h>
+#include <zmk/event_manager.h>
+#include <zmk/events/activity_state_changed.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BATTERY_REPORTING)
+#include <zmk/battery.h>
+#include <zmk/events/battery_state_changed.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+#include <zmk/ble.h>
+#include <zmk/events/ble_active_profile_changed.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_EXT_POWER)
+#include <drivers/ext_power.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RGB_UNDERGLOW)
+#include <zmk/rgb_underglow.h>
+#endif
+
+#include <deemen17/energy.h>
+#include <deemen17/listener_profile.h>
+
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1,
+             "Exactly one deemen17,energy-model node is supported");
+
+#define UAMS_PER_UAH (3600U * MSEC_PER_SEC)
+
+#define CROSS_CHECK_BATTERY                                                                        \
+    (DT_INST_PROP(0, cross_check_battery) && IS_ENABLED(CONFIG_ZMK_BATTERY_REPORTING))
+
+// Same order as the binding's source enum
+enum energy_load {
+    ENERGY_LOAD_LED,
+    ENERGY_LOAD_BUZZER,
+    ENERGY_LOAD_EXT_POWER,
+    ENERGY_LOAD_UNDERGLOW,
+    ENERGY_LOAD_BLE_CONNECTION,
+};
+
+struct energy_channel {
+    const char *name;
+    const struct device *led_dev;
+    uint32_t led_index;
+    uint32_t current_ua;
+    enum energy_load load;
+};
+
+#define ENERGY_CHANNEL(child)                                                                      \
+    {                                                                                              \
+        .name = DT_NODE_FULL_NAME(child),                                                          \
+        .led_dev = COND_CODE_1(DT_NODE_HAS_PROP(child, led),                                       \
+                               (DEVICE_DT_GET(DT_PARENT(DT_PHANDLE(child, led)))), (NULL)),        \
+        .led_index =                                                                               \
+            COND_CODE_1(DT_NODE_HAS_PROP(child, led), (DT_NODE_CHILD_IDX(DT_PHANDLE(child, led))), \
+                        (0)),                                                                      \
+        .current_ua = DT_PROP(child, current_ua),                                                  \
+        .load = DT_ENUM_IDX(child, source),                                                        \
+    },
+
+static const struct energy_channel channels[] = {
+    DT_INST_FOREACH_CHILD_STATUS_OKAY(0, ENERGY_CHANNEL)};
+
+static const char *const state_names[] = {"active", "idle", "sleep"};
+
+// Indexed by enum zmk_activity_state
+static const uint32_t state_current_ua[] = {
+    DT_INST_PROP(0, active_current_ua),
+    DT_INST_PROP(0, idle_current_ua),
+    DT_INST_PROP(0, sleep_current_ua),
+};
+
+// Time a load has been on, in uptime milliseconds
+struct energy_counter {
+    int64_t since;
+    uint64_t on_ms;
+    bool on;
+};
+
+static struct energy_counter channel_counters[ARRAY_SIZE(channels)];
+static struct energy_counter state_counters[ARRAY_SIZE(state_current_ua)];
+static int64_t reset_time;
+static struct k_spinlock lock;
+static bool sampled; // Some channel is a polled load
+
+#if CROSS_CHECK_BATTERY
+// Gauge reading and modelled charge at the start of the current discharge
+static int16_t soc_start = -1;
+static uint64_t soc_start_uams;
+#endif
+
+static void counter_set(struct energy_counter *counter, bool on, int64_t now) {
+    if (counter->on == on) {
+        return;
+    }
+
+    if (counter->on) {
+        counter->on_ms += now - counter->since;
+    }
+    counter->on = on;
+    counter->since = now;
+}
+
+static uint64_t counter_ms(const struct energy_counter *counter, int64_t now) {
+    return counter->on_ms + (counter->on ? now - counter->since : 0);
+}
+
+// Modelled charge since reset in microamp milliseconds. Called with the lock held.
+static uint64_t total_uams(int64_t now) {
+    uint64_t uams = 0;
+
+    for (int s = 0; s < ARRAY_SIZE(state_counters); s++) {
+        uams += counter_ms(&state_counters[s], now) * state_current_ua[s];
+    }
+
+    for (int i = 0; i < ARRAY_SIZE(channels); i++) {
+        uams += counter_ms(&channel_counters[i], now) * channels[i].current_ua;
+    }
+
+    return uams;
+}
+
+static void load_set(enum energy_load load, bool on) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    int64_t now = k_uptime_get();
+
+    for (int i = 0; i < ARRAY_SIZE(channels); i++) {
+        if (channels[i].load == load) {
+            counter_set(&channel_counters[i], on, now);
+        }
+    }
+
+    k_spin_unlock(&lock, key);
+}
+
+void energy_led_set(const struct device *dev, uint32_t led, bool on) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    int64_t now = k_uptime_get();
+
+    for (int i = 0; i < ARRAY_SIZE(channels); i++) {
+        const struct energy_channel *channel = &channels[i];
+
+        if (channel->load == ENERGY_LOAD_LED && channel->led_dev == dev &&
+            channel->led_index == led) {
+            counter_set(&channel_counters[i], on, now);
+        }
+    }
+
+    k_spin_unlock(&lock, key);
+}
+
+void energy_source_set(enum energy_source source, bool on) {
+    switch (source) {
+    case ENERGY_SOURCE_BUZZER:
+        load_set(ENERGY_LOAD_BUZZER, on);
+        break;
+    }
+}
+
+// Loads ZMK has no events for are polled; returns false if the load cannot be read
+static bool load_sample(enum energy_load load, bool *on) {
+    switch (load) {
+#if IS_ENABLED(CONFIG_ZMK_EXT_POWER) && DT_HAS_COMPAT_STATUS_OKAY(zmk_ext_power_generic)
+    case ENERGY_LOAD_EXT_POWER:
+        *on = ext_power_get(DEVICE_DT_GET_ANY(zmk_ext_power_generic)) > 0;
+        return true;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_RGB_UNDERGLOW)
+    case ENERGY_LOAD_UNDERGLOW:
+        return zmk_rgb_underglow_get_state(on) == 0;
+#endif
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    case ENERGY_LOAD_BLE_CONNECTION:
+        *on = zmk_ble_active_profile_is_connected();
+        return true;
+#endif
+    default:
+        return false;
+    }
+}
+
+static void energy_sample_work_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(energy_sample_work, energy_sample_work_cb);
+
+// Polls only while active; idle and sleep get one sample on the way in, and the
+// loads only change from then on through events that sample again
+static void energy_sample_work_cb(struct k_work *work) {
+    for (int load = ENERGY_LOAD_EXT_POWER; load <= ENERGY_LOAD_BLE_CONNECTION; load++) {
+        bool on;
+
+        if (load_sample(load, &on)) {
+            load_set(load, on);
+        }
+    }
+
+    if (zmk_activity_get_state() == ZMK_ACTIVITY_ACTIVE) {
+        k_work_schedule(&energy_sample_work, K_MSEC(CONFIG_DEEMEN17_ENERGY_SAMPLE_MS));
+    }
+}
+
+// From the work queue, after every listener has acted on the event
+static void energy_sample_now(void) {
+    if (sampled) {
+        k_work_reschedule(&energy_sample_work, K_NO_WAIT);
+    }
+}
+
+static int energy_activity_listener(const zmk_event_t *eh) {
+    const struct zmk_activity_state_changed *ev = as_zmk_activity_state_changed(eh);
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    int64_t now = k_uptime_get();
+
+    for (int s = 0; s < ARRAY_SIZE(state_counters); s++) {
+        counter_set(&state_counters[s], s == ev->state, now);
+    }
+
+    k_spin_unlock(&lock, key);
+
+    // Underglow and external power are switched off on idle and sleep
+    energy_sample_now();
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_energy_activity, energy_activity_listener);
+ZMK_SUBSCRIPTION(deemen17_energy_activity, zmk_activity_state_changed);
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+// Also raised when the active profile connects or disconnects, which happens while idle
+static int energy_ble_listener(const zmk_event_t *eh) {
+    energy_sample_now();
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_energy_ble, energy_ble_listener);
+ZMK_SUBSCRIPTION(deemen17_energy_ble, zmk_ble_active_profile_changed);
+#endif
+
+#if CROSS_CHECK_BATTERY
+static int energy_battery_listener(const zmk_event_t *eh) {
+    const struct zmk_battery_state_changed *ev = as_zmk_battery_state_changed(eh);
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    // A rising gauge means the battery was charged, start a new discharge from here
+    if (soc_start < 0 || ev->state_of_charge > soc_start) {
+        soc_start = ev->state_of_charge;
+        soc_start_uams = total_uams(k_uptime_get());
+    }
+
+    k_spin_unlock(&lock, key);
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_energy_battery, energy_battery_listener);
+ZMK_SUBSCRIPTION(deemen17_energy_battery, zmk_battery_state_changed);
+#endif
+
+static uint32_t uams_to_uah(uint64_t uams) { return (uint32_t)(uams / UAMS_PER_UAH); }
+
+static void energy_print(void (*print)(void *ctx, const char *line), void *ctx) {
+    struct energy_counter channel_snapshot[ARRAY_SIZE(channels)];
+    struct energy_counter state_snapshot[ARRAY_SIZE(state_counters)];
+    char line[96];
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    int64_t now = k_uptime_get();
+    uint64_t elapsed_ms = now - reset_time;
+    uint64_t used_uams = total_uams(now);
+#if CROSS_CHECK_BATTERY
+    int16_t soc_from = soc_start;
+    uint64_t since_soc_uams = used_uams - soc_start_uams;
+#endif
+
+    memcpy(channel_snapshot, channel_counters, sizeof(channel_snapshot));
+    memcpy(state_snapshot, state_counters, sizeof(state_snapshot));
+    k_spin_unlock(&lock, key);
+
+    uint32_t used_uah = uams_to_uah(used_uams);
+    uint32_t average_ua = elapsed_ms ? (uint32_t)(used_uams / elapsed_ms) : 0;
+
+    snprintk(line, sizeof(line), "%u s, average %u uA, used %u.%03u mAh",
+             (uint32_t)(elapsed_ms / MSEC_PER_SEC), average_ua, used_uah / 1000, used_uah % 1000);
+    print(ctx, line);
+
+    for (int s = 0; s < ARRAY_SIZE(state_snapshot); s++) {
+        uint64_t ms = counter_ms(&state_snapshot[s], now);
+        uint32_t uah = uams_to_uah(ms * state_current_ua[s]);
+
+        snprintk(line, sizeof(line), "  %s: %u s, %u.%03u mAh", state_names[s],
+                 (uint32_t)(ms / MSEC_PER_SEC), uah / 1000, uah % 1000);
+        print(ctx, line);
+    }
+
+    for (int i = 0; i < ARRAY_SIZE(channels); i++) {
+        uint64_t ms = counter_ms(&channel_snapshot[i], now);
+        uint32_t uah = uams_to_uah(ms * channels[i].current_ua);
+
+        snprintk(line, sizeof(line), "  %s: on %u s, %u.%03u mAh", channels[i].name,
+                 (uint32_t)(ms / MSEC_PER_SEC), uah / 1000, uah % 1000);
+        print(ctx, line);
+    }
+
+    if (average_ua == 0) {
+        return;
+    }
+
+    uint32_t capacity_uah = DT_INST_PROP(0, battery_capacity_mah) * 1000U;
+
+#if IS_ENABLED(CONFIG_ZMK_BATTERY_REPORTING)
+    uint8_t soc = zmk_battery_state_of_charge();
+
+    snprintk(line, sizeof(line), "battery %u%%, about %u h left, %u h from full", soc,
+             capacity_uah / 100U * soc / average_ua, capacity_uah / average_ua);
+#else
+    snprintk(line, sizeof(line), "a full battery lasts about %u h", capacity_uah / average_ua);
+#endif
+    print(ctx, line);
+
+#if CROSS_CHECK_BATTERY
+    if (soc_from >= soc) {
+        uint32_t gauge_uah = capacity_uah / 100U * (soc_from - soc);
+        uint32_t model_uah = uams_to_uah(since_soc_uams);
+
+        snprintk(line, sizeof(line), "since %d%%: gauge %u.%03u mAh, model %u.%03u mAh", soc_from,
+                 gauge_uah / 1000, gauge_uah % 1000, model_uah / 1000, model_uah % 1000);
+        print(ctx, line);
+    }
+#endif
+}
+
+static void energy_reset(void) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    int64_t now = k_uptime_get();
+
+    reset_time = now;
+    for (int i = 0; i < ARRAY_SIZE(channel_counters); i++) {
+        channel_counters[i].on_ms = 0;
+        channel_counters[i].since = now;
+    }
+    for (int s = 0; s < ARRAY_SIZE(state_counters); s++) {
+        state_counters[s].on_ms = 0;
+        state_counters[s].since = now;
+    }
+#if CROSS_CHECK_BATTERY
+    soc_start = -1;
+#endif
+
+    k_spin_unlock(&lock, key);
+}
+
+#if CONFIG_DEEMEN17_ENERGY_LOG_INTERVAL > 0
+static void log_line(void *ctx, const char *line) { LOG_INF("energy %s", line); }
+
+static void energy_log_work_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(energy_log_work, energy_log_work_cb);
+
+static void energy_log_work_cb(struct k_work *work) {
+    energy_print(log_line, NULL);
+    k_work_schedule(&energy_log_work, K_SECONDS(CONFIG_DEEMEN17_ENERGY_LOG_INTERVAL));
+}
+#endif
+
+#if IS_ENABLED(CONFIG_SHELL)
+static void shell_line(void *ctx, const char *line) {
+    shell_print((const struct shell *)ctx, "%s", line);
+}
+
+static int cmd_energy_show(const struct shell *sh, size_t argc, char **argv) {
+    energy_print(shell_line, (void *)sh);
+    return 0;
+}
+
+static int cmd_energy_reset(const struct shell *sh, size_t argc, char **argv) {
+    energy_reset();
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_energy,
+                               SHELL_CMD(show, NULL, "Print energy counters", cmd_energy_show),
+                               SHELL_CMD(reset, NULL, "Clear energy counters", cmd_energy_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(energy, &sub_energy, "Energy accounting", NULL);
+#endif
+
+static int energy_init(void) {
+    for (int i = 0; i < ARRAY_SIZE(channels); i++) {
+        if (channels[i].led_dev && !device_is_ready(channels[i].led_dev)) {
+            LOG_WRN("Energy channel %s: LED device not ready", channels[i].name);
+        }
+        sampled |= channels[i].load >= ENERGY_LOAD_EXT_POWER;
+    }
+
+    energy_reset();
+    counter_set(&state_counters[zmk_activity_get_state()], true, reset_time);
+
+    energy_sample_now();
+
+#if CONFIG_DEEMEN17_ENERGY_LOG_INTERVAL > 0
+    k_work_schedule(&energy_log_work, K_SECONDS(CONFIG_DEEMEN17_ENERGY_LOG_INTERVAL));
+#endif
+
+    return 0;
+}
+
+SYS_INIT(energy_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
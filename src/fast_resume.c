@@ -0,0 +1,403 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_fast_resume
+
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/hwinfo.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#endif
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/endpoints.h>
+#include <zmk/event_manager.h>
+#include <zmk/matrix_transform.h>
+#include <zmk/physical_layouts.h>
+#include <zmk/events/endpoint_changed.h>
+#include <zmk/events/position_state_changed.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+#include <zmk/ble.h>
+#include <zmk/events/ble_active_profile_changed.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_USB)
+#include <zmk/usb.h>
+#include <zmk/events/usb_conn_state_changed.h>
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_RGB_UNDERGLOW)
+#include <zmk/rgb_underglow.h>
+#endif
+
+#include <deemen17/fast_resume.h>
+#include <deemen17/listener_profile.h>
+
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1,
+             "Exactly one deemen17,fast-resume node is supported");
+
+#define WAKE_KEY_ROW DT_INST_PROP(0, wakeup_key_row)
+#define WAKE_KEY_COLUMN DT_INST_PROP(0, wakeup_key_column)
+#define RESUME_TIMEOUT_MS DT_INST_PROP(0, resume_timeout_ms)
+#define DIRECT_ADV_MS DT_INST_PROP(0, direct_adv_ms)
+
+#define MAX_DEFERRED_JOBS 4
+
+struct deferred_job {
+    struct feedback_job *job;
+    uint32_t delay_ms;
+    uint32_t slack_ms;
+};
+
+static struct {
+    bool woke;              // This boot is a wake from soft-off
+    bool resuming;          // Woke and the first report has not been sent yet
+    bool wake_key_pending;  // The wakeup key was not replayed or let through yet
+    bool wake_key_held;     // Its press was scanned and is held back for the replay
+    bool wake_key_released; // Its release was scanned too
+    bool underglow_held;    // Underglow was on and is held off until the first report
+    atomic_t report_sent;
+    // Uptime counts from the reset out of soft-off, so this leaves out the time from
+    // the wake press to the kernel clock starting
+    uint32_t first_report_uptime_ms;
+    struct deferred_job deferred[MAX_DEFERRED_JOBS];
+    uint8_t deferred_count;
+} resume;
+
+static void fast_resume_end(struct k_work *work);
+static K_WORK_DEFINE(end_work, fast_resume_end);
+static K_WORK_DELAYABLE_DEFINE(timeout_work, fast_resume_end);
+
+static void wake_key_replay(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(replay_work, wake_key_replay);
+
+void fast_resume_defer(struct feedback_job *job, uint32_t delay_ms, uint32_t slack_ms) {
+    if (!resume.resuming || resume.deferred_count == MAX_DEFERRED_JOBS) {
+        feedback_job_schedule(job, delay_ms, slack_ms);
+        return;
+    }
+
+    resume.deferred[resume.deferred_count++] = (struct deferred_job){
+        .job = job,
+        .delay_ms = delay_ms,
+        .slack_ms = slack_ms,
+    };
+}
+
+void fast_resume_report_sent(void) {
+    if (!resume.woke || !atomic_cas(&resume.report_sent, 0, 1)) {
+        return;
+    }
+
+    resume.first_report_uptime_ms = k_uptime_get_32();
+    k_work_submit(&end_work);
+}
+
+// Runs the init held back while resuming, after the first report or the timeout
+static void fast_resume_end(struct k_work *work) {
+    if (!resume.resuming) {
+        return;
+    }
+    resume.resuming = false;
+    k_work_cancel_delayable(&timeout_work);
+
+    if (atomic_get(&resume.report_sent)) {
+        LOG_INF("Woke from soft-off, first report at %u ms uptime",
+                resume.first_report_uptime_ms);
+    } else {
+        LOG_WRN("Woke from soft-off, no report within %u ms", RESUME_TIMEOUT_MS);
+
+        // A press held back is still let through, so its release is not orphaned
+        k_work_cancel_delayable(&replay_work);
+        if (resume.wake_key_held) {
+            wake_key_replay(NULL);
+        }
+        resume.wake_key_pending = false;
+    }
+
+    for (int i = 0; i < resume.deferred_count; i++) {
+        const struct deferred_job *d = &resume.deferred[i];
+
+        feedback_job_schedule(d->job, d->delay_ms, d->slack_ms);
+    }
+    resume.deferred_count = 0;
+
+#if IS_ENABLED(CONFIG_ZMK_RGB_UNDERGLOW)
+    if (resume.underglow_held) {
+        resume.underglow_held = false;
+        zmk_rgb_underglow_on();
+    }
+#endif
+}
+
+static int32_t wake_key_position(void) {
+    struct zmk_physical_layout const *const *layouts;
+    int selected = zmk_physical_layouts_get_selected();
+
+    if (selected < 0 || zmk_physical_layouts_get_list(&layouts) <= selected) {
+        return -ENODEV;
+    }
+
+    return zmk_matrix_transform_row_column_to_position(layouts[selected]->matrix_transform,
+                                                       WAKE_KEY_ROW, WAKE_KEY_COLUMN);
+}
+
+static void wake_key_replay(struct k_work *work) {
+    int32_t position;
+    int64_t now = k_uptime_get();
+
+    if (!resume.wake_key_pending) {
+        return;
+    }
+    resume.wake_key_pending = false;
+
+    position = wake_key_position();
+    if (position < 0) {
+        LOG_WRN("Wakeup key is not in the selected layout");
+        return;
+    }
+
+    LOG_DBG("Replaying wakeup key at position %d", position);
+    raise_zmk_position_state_changed((struct zmk_position_state_changed){
+        .source = ZMK_POSITION_STATE_CHANGE_SOURCE_LOCAL,
+        .state = true,
+        .position = position,
+        .timestamp = now,
+    });
+
+    // Still held: the scanned release comes through on its own
+    if (resume.wake_key_held && !resume.wake_key_released) {
+        return;
+    }
+
+    raise_zmk_position_state_changed((struct zmk_position_state_changed){
+        .source = ZMK_POSITION_STATE_CHANGE_SOURCE_LOCAL,
+        .state = false,
+        .position = position,
+        .timestamp = now,
+    });
+}
+
+// A report for the selected endpoint would reach the host now
+static bool endpoint_ready(void) {
+    struct zmk_endpoint_instance endpoint = zmk_endpoints_selected();
+
+    switch (endpoint.transport) {
+#if IS_ENABLED(CONFIG_ZMK_USB)
+    case ZMK_TRANSPORT_USB:
+        return zmk_usb_is_hid_ready();
+#endif
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    case ZMK_TRANSPORT_BLE: {
+        // Input reports need the link encrypted, which comes after the connection
+        struct bt_conn *conn;
+        bool ready;
+
+        if (!zmk_ble_active_profile_is_connected()) {
+            return false;
+        }
+
+        conn = bt_conn_lookup_addr_le(BT_ID_DEFAULT, zmk_ble_active_profile_addr());
+        if (!conn) {
+            return false;
+        }
+        ready = bt_conn_get_security(conn) >= BT_SECURITY_L2;
+        bt_conn_unref(conn);
+        return ready;
+    }
+#endif
+    default:
+        return false;
+    }
+}
+
+static void fast_resume_check_endpoint(void) {
+    if (resume.wake_key_pending && endpoint_ready()) {
+        k_work_schedule(&replay_work, K_NO_WAIT);
+    }
+}
+
+static int fast_resume_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *pos = as_zmk_position_state_changed(eh);
+
+    if (!resume.wake_key_pending) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    // The wakeup key scanned while still held is held back for the replay
+    if (pos && pos->source == ZMK_POSITION_STATE_CHANGE_SOURCE_LOCAL &&
+        pos->position == wake_key_position()) {
+        if (pos->state && !resume.wake_key_held) {
+            resume.wake_key_held = true;
+            fast_resume_check_endpoint();
+            return ZMK_EV_EVENT_HANDLED;
+        }
+        if (!pos->state && resume.wake_key_held && !resume.wake_key_released) {
+            resume.wake_key_released = true;
+            fast_resume_check_endpoint();
+            return ZMK_EV_EVENT_HANDLED;
+        }
+    }
+
+    // Another key, or the wakeup key again: a held back press goes out ahead of it,
+    // an unscanned wakeup key is not replayed at all since that would reorder keys
+    if (pos) {
+        k_work_cancel_delayable(&replay_work);
+        if (resume.wake_key_held) {
+            wake_key_replay(NULL);
+        }
+        resume.wake_key_pending = false;
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    fast_resume_check_endpoint();
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_fast_resume, fast_resume_listener);
+ZMK_SUBSCRIPTION(deemen17_fast_resume, zmk_position_state_changed);
+ZMK_SUBSCRIPTION(deemen17_fast_resume, zmk_endpoint_changed);
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+ZMK_SUBSCRIPTION(deemen17_fast_resume, zmk_ble_active_profile_changed);
+#endif
+#if IS_ENABLED(CONFIG_ZMK_USB)
+ZMK_SUBSCRIPTION(deemen17_fast_resume, zmk_usb_conn_state_changed);
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+int __real_bt_le_adv_start(const struct bt_le_adv_param *param, const struct bt_data *ad,
+                           size_t ad_len, const struct bt_data *sd, size_t sd_len);
+int __real_bt_le_adv_stop(void);
+
+// Advertising ZMK asked for while directed advertising runs in its place
+static struct {
+    bool direct;      // Directed advertising to the bonded host is running
+    bool allowed;     // Still within direct-adv-ms of the wake
+    struct bt_le_adv_param param;
+    const struct bt_data *ad;
+    size_t ad_len;
+    const struct bt_data *sd;
+    size_t sd_len;
+} adv;
+
+int fast_resume_adv_start(const struct bt_le_adv_param *param, const struct bt_data *ad,
+                          size_t ad_len, const struct bt_data *sd, size_t sd_len) {
+    struct bt_le_adv_param direct;
+
+    adv.direct = false;
+
+    // Only a connectable, undirected start for a bonded profile is redirected
+    if (!adv.allowed || param->peer || !(param->options & BT_LE_ADV_OPT_CONNECTABLE) ||
+        zmk_ble_active_profile_is_open()) {
+        return __real_bt_le_adv_start(param, ad, ad_len, sd, sd_len);
+    }
+
+    direct = (struct bt_le_adv_param)BT_LE_ADV_PARAM_INIT(
+        BT_LE_ADV_OPT_CONNECTABLE | BT_LE_ADV_OPT_DIR_MODE_LOW_DUTY |
+            (param->options & BT_LE_ADV_OPT_ONE_TIME),
+        BT_GAP_ADV_FAST_INT_MIN_1, BT_GAP_ADV_FAST_INT_MAX_1, zmk_ble_active_profile_addr());
+    direct.id = param->id;
+
+    if (__real_bt_le_adv_start(&direct, NULL, 0, NULL, 0) != 0) {
+        return __real_bt_le_adv_start(param, ad, ad_len, sd, sd_len);
+    }
+
+    adv.direct = true;
+    adv.param = *param;
+    adv.ad = ad;
+    adv.ad_len = ad_len;
+    adv.sd = sd;
+    adv.sd_len = sd_len;
+    LOG_DBG("Directed advertising to the active profile");
+
+    return 0;
+}
+
+void fast_resume_adv_stopped(void) { adv.direct = false; }
+
+// The host did not take the directed advertising; fall back to what ZMK asked for
+static void direct_adv_expired(struct k_work *work) {
+    adv.allowed = false;
+
+    if (!adv.direct) {
+        return;
+    }
+    adv.direct = false;
+
+    __real_bt_le_adv_stop();
+    __real_bt_le_adv_start(&adv.param, adv.ad, adv.ad_len, adv.sd, adv.sd_len);
+}
+
+static K_WORK_DELAYABLE_DEFINE(direct_adv_work, direct_adv_expired);
+
+static void fast_resume_connected(struct bt_conn *conn, uint8_t err) {
+    if (!err) {
+        adv.direct = false;
+    }
+}
+
+static void fast_resume_security_changed(struct bt_conn *conn, bt_security_t level,
+                                         enum bt_security_err err) {
+    if (!err) {
+        fast_resume_check_endpoint();
+    }
+}
+
+BT_CONN_CB_DEFINE(fast_resume_conn_callbacks) = {
+    .connected = fast_resume_connected,
+    .security_changed = fast_resume_security_changed,
+};
+#endif
+
+static int fast_resume_init(void) {
+    uint32_t cause = 0;
+
+    if (hwinfo_get_reset_cause(&cause) == 0) {
+        hwinfo_clear_reset_cause();
+    }
+
+    if (!(cause & RESET_LOW_POWER_WAKE)) {
+        return 0;
+    }
+
+    resume.woke = true;
+    resume.resuming = true;
+    resume.wake_key_pending = true;
+    k_work_schedule(&timeout_work, K_MSEC(RESUME_TIMEOUT_MS));
+
+#if IS_ENABLED(CONFIG_ZMK_BLE)
+    adv.allowed = true;
+    k_work_schedule(&direct_adv_work, K_MSEC(DIRECT_ADV_MS));
+#endif
+
+    return 0;
+}
+
+#if IS_ENABLED(CONFIG_ZMK_RGB_UNDERGLOW)
+// Keep the strip and its external power off until the first report is out
+static int fast_resume_hold_underglow(void) {
+    bool on = false;
+
+    if (resume.resuming && zmk_rgb_underglow_get_state(&on) == 0 && on) {
+        resume.underglow_held = zmk_rgb_underglow_off() == 0;
+    }
+
+    return 0;
+}
+
+// After the underglow driver restored its saved state
+SYS_INIT(fast_resume_hold_underglow, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY + 1);
+#endif
+
+// Ahead of the application modules that defer their init through fast_resume_defer()
+SYS_INIT(fast_resume_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <deemen17/feedback.h>
+
+// Queued jobs, sorted by deadline
+static sys_slist_t jobs = SYS_SLIST_STATIC_INIT(&jobs);
+static struct k_spinlock lock;
+
+static void feedback_dispatch(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(dispatch_work, feedback_dispatch);
+
+#if IS_ENABLED(CONFIG_DEEMEN17_FEEDBACK_THREAD)
+static K_THREAD_STACK_DEFINE(feedback_stack, CONFIG_DEEMEN17_FEEDBACK_STACK_SIZE);
+static struct k_work_q feedback_queue;
+#define FEEDBACK_QUEUE (&feedback_queue)
+#else
+#define FEEDBACK_QUEUE (&k_sys_work_q)
+#endif
+
+#if IS_ENABLED(CONFIG_DEEMEN17_FEEDBACK_STATS)
+static struct {
+    uint32_t max_late_us; // Release time to handler start
+    uint32_t max_run_us;  // Handler run time
+    uint32_t missed;      // Jobs started after their deadline
+} feedback_stats;
+
+static void feedback_stats_record(const struct feedback_job *job, int64_t started,
+                                  uint32_t start_cycles) {
+    uint32_t late_us = (uint32_t)k_ticks_to_us_ceil64(started - job->release);
+    uint32_t run_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start_cycles);
+
+    if (started > job->deadline) {
+        feedback_stats.missed++;
+    }
+
+    if (late_us <= feedback_stats.max_late_us && run_us <= feedback_stats.max_run_us) {
+        return;
+    }
+
+    feedback_stats.max_late_us = MAX(feedback_stats.max_late_us, late_us);
+    feedback_stats.max_run_us = MAX(feedback_stats.max_run_us, run_us);
+
+#if IS_ENABLED(CONFIG_DEEMEN17_FEEDBACK_THREAD)
+    size_t unused = 0;
+
+    k_thread_stack_space_get(&feedback_queue.thread, &unused);
+    LOG_INF("Feedback worst case: %u us late, %u us run, %u missed, %u B stack unused",
+            feedback_stats.max_late_us, feedback_stats.max_run_us, feedback_stats.missed,
+            (uint32_t)unused);
+#else
+    LOG_INF("Feedback worst case: %u us late, %u us run, %u missed", feedback_stats.max_late_us,
+            feedback_stats.max_run_us, feedback_stats.missed);
+#endif
+}
+#endif
+
+// Point the dispatcher at the earliest release time. Called with the lock held so
+// a concurrent dispatch cannot push it back to a later time.
+static void feedback_arm(void) {
+    struct feedback_job *job;
+    int64_t next = INT64_MAX;
+
+    SYS_SLIST_FOR_EACH_CONTAINER(&jobs, job, node) { next = MIN(next, job->release); }
+
+    if (next != INT64_MAX) {
+        k_work_reschedule_for_queue(FEEDBACK_QUEUE, &dispatch_work, K_TIMEOUT_ABS_TICKS(next));
+    }
+}
+
+static void feedback_unlink(struct feedback_job *job) {
+    sys_slist_find_and_remove(&jobs, &job->node);
+    job->queued = false;
+}
+
+static void feedback_dispatch(struct k_work *work) {
+    while (true) {
+        struct feedback_job *job, *run = NULL;
+        k_spinlock_key_t key = k_spin_lock(&lock);
+        int64_t now = k_uptime_ticks();
+
+        SYS_SLIST_FOR_EACH_CONTAINER(&jobs, job, node) {
+            if (job->release <= now) {
+                run = job;
+                break;
+            }
+        }
+
+        if (!run) {
+            feedback_arm();
+            k_spin_unlock(&lock, key);
+            return;
+        }
+
+        feedback_unlink(run);
+        k_spin_unlock(&lock, key);
+
+#if IS_ENABLED(CONFIG_DEEMEN17_FEEDBACK_STATS)
+        uint32_t start_cycles = k_cycle_get_32();
+
+        run->handler(run);
+        feedback_stats_record(run, now, start_cycles);
+#else
+        run->handler(run);
+#endif
+    }
+}
+
+void feedback_job_init(struct feedback_job *job, feedback_job_handler_t handler) {
+    *job = (struct feedback_job)FEEDBACK_JOB_INITIALIZER(handler);
+}
+
+void feedback_job_schedule(struct feedback_job *job, uint32_t delay_ms, uint32_t slack_ms) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    struct feedback_job *it;
+    sys_snode_t *prev = NULL;
+
+    if (job->queued) {
+        feedback_unlink(job);
+    }
+
+    job->release = k_uptime_ticks() + k_ms_to_ticks_ceil64(delay_ms);
+    job->deadline = job->release + k_ms_to_ticks_ceil64(slack_ms);
+
+    SYS_SLIST_FOR_EACH_CONTAINER(&jobs, it, node) {
+        if (it->deadline > job->deadline) {
+            break;
+        }
+        prev = &it->node;
+    }
+
+    sys_slist_insert(&jobs, prev, &job->node);
+    job->queued = true;
+    feedback_arm();
+
+    k_spin_unlock(&lock, key);
+}
+
+bool feedback_job_cancel(struct feedback_job *job) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+    bool queued = job->queued;
+
+    if (queued) {
+        feedback_unlink(job);
+    }
+
+    k_spin_unlock(&lock, key);
+    return queued;
+}
+
+bool feedback_job_is_queued(const struct feedback_job *job) { return job->queued; }
+
+#if IS_ENABLED(CONFIG_DEEMEN17_FEEDBACK_THREAD)
+static int feedback_init(void) {
+    k_work_queue_init(&feedback_queue);
+    k_work_queue_start(&feedback_queue, feedback_stack, K_THREAD_STACK_SIZEOF(feedback_stack),
+                       CONFIG_DEEMEN17_FEEDBACK_THREAD_PRIORITY, NULL);
+    k_thread_name_set(&feedback_queue.thread, "feedback");
+
+    return 0;
+}
+
+// Ahead of the application modules that schedule jobs from their own SYS_INIT
+SYS_INIT(feedback_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+#endif
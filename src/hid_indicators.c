@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_hid_indicators
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/led.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/hid_indicators.h>
+#include <zmk/events/hid_indicators_changed.h>
+
+#include <deemen17/energy.h>
+#include <deemen17/feedback.h>
+#include <deemen17/listener_profile.h>
+
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) == 1,
+             "Exactly one deemen17,hid-indicators node is supported");
+
+// Indicator changes only need to reach the LEDs within this time
+#define LED_UPDATE_SLACK_MS 20
+
+struct hid_indicator_led {
+    const struct device *dev;
+    uint32_t index;
+    zmk_hid_indicators_t mask;
+};
+
+// HID LED usage n is bit n - 1 of the indicator report
+#define HID_INDICATOR_LED(child)                                                                   \
+    {                                                                                              \
+        .dev = DEVICE_DT_GET(DT_PARENT(DT_PHANDLE(child, led))),                                   \
+        .index = DT_NODE_CHILD_IDX(DT_PHANDLE(child, led)),                                        \
+        .mask = BIT(DT_PROP(child, indicator) - 1),                                                \
+    },
+
+static const struct hid_indicator_led indicator_leds[] = {
+    DT_INST_FOREACH_CHILD_STATUS_OKAY(0, HID_INDICATOR_LED)};
+
+// Indicator bits the LEDs currently show
+static zmk_hid_indicators_t shadow;
+
+static void hid_indicators_update(struct feedback_job *job) {
+    zmk_hid_indicators_t flags = zmk_hid_indicators_get_current_profile();
+    zmk_hid_indicators_t changed = flags ^ shadow;
+
+    if (!changed) {
+        return;
+    }
+
+    for (int i = 0; i < ARRAY_SIZE(indicator_leds); i++) {
+        const struct hid_indicator_led *led = &indicator_leds[i];
+
+        if (!(changed & led->mask)) {
+            continue;
+        }
+
+        if (flags & led->mask) {
+            led_on(led->dev, led->index);
+        } else {
+            led_off(led->dev, led->index);
+        }
+        energy_led_set(led->dev, led->index, flags & led->mask);
+    }
+
+    shadow = flags;
+}
+
+static FEEDBACK_JOB_DEFINE(hid_indicators_job, hid_indicators_update);
+
+static int hid_indicators_listener(const zmk_event_t *eh) {
+    if (zmk_hid_indicators_get_current_profile() != shadow) {
+        feedback_job_schedule(&hid_indicators_job, 0, LED_UPDATE_SLACK_MS);
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_hid_indicators, hid_indicators_listener);
+ZMK_SUBSCRIPTION(deemen17_hid_indicators, zmk_hid_indicators_changed);
+
+static int hid_indicators_init(void) {
+    for (int i = 0; i < ARRAY_SIZE(indicator_leds); i++) {
+        if (!device_is_ready(indicator_leds[i].dev)) {
+            LOG_ERR("Indicator LED device %s not ready", indicator_leds[i].dev->name);
+            return -ENODEV;
+        }
+    }
+
+    return 0;
+}
+
+SYS_INIT(hid_indicators_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,33 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Linked with -Wl,--wrap=zmk_endpoints_send_report, every HID report ZMK sends
+// from its listeners passes through here on the way to the selected transport.
+
+#include <zephyr/kernel.h>
+
+#include <zmk/endpoints.h>
+
+#include <deemen17/boot_profile.h>
+#include <deemen17/fast_resume.h>
+#include <deemen17/latency_trace.h>
+
+int __real_zmk_endpoints_send_report(uint16_t usage_page);
+
+int __wrap_zmk_endpoints_send_report(uint16_t usage_page) {
+    int ret = __real_zmk_endpoints_send_report(usage_page);
+
+#if IS_ENABLED(CONFIG_DEEMEN17_LATENCY_TRACE)
+    latency_trace_report_sent(zmk_endpoints_selected().transport);
+#endif
+
+    if (ret == 0) {
+        boot_profile_mark(BOOT_STAGE_FIRST_REPORT);
+        fast_resume_report_sent();
+    }
+
+    return ret;
+}
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/timing/timing.h>
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+#include <zmk/events/position_state_changed.h>
+#include <zmk/events/keycode_state_changed.h>
+
+#include <deemen17/latency_trace.h>
+#include <deemen17/listener_profile.h>
+
+// Bucket 0 holds samples below 1 us, bucket n holds [2^(n-1), 2^n) us
+#define LATENCY_BUCKETS 22
+#define LATENCY_IN_FLIGHT 8
+
+enum latency_stage {
+    LATENCY_STAGE_DISPATCH,   // position event raised -> keymap input, includes combo buffering
+    LATENCY_STAGE_KEYMAP,     // keymap input -> keycode, includes hold-tap decisions
+    LATENCY_STAGE_REPORT_USB, // keycode -> HID report submitted over USB
+    LATENCY_STAGE_REPORT_BLE, // keycode -> HID report submitted over BLE
+    LATENCY_STAGE_TOTAL_USB,  // kscan -> USB report
+    LATENCY_STAGE_TOTAL_BLE,  // kscan -> BLE report
+    LATENCY_STAGE_COUNT,
+};
+
+static const char *const stage_names[LATENCY_STAGE_COUNT] = {
+    "dispatch", "keymap", "report_usb", "report_ble", "total_usb", "total_ble",
+};
+
+struct latency_hist {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t sum_us;
+    uint32_t buckets[LATENCY_BUCKETS];
+};
+
+// A press from the moment ZMK raises it, matched to its keycode by the kscan timestamp
+struct latency_key {
+    int64_t timestamp;
+    uint32_t position;
+    timing_t raised;
+    timing_t dispatched;
+    uint32_t dispatch_us;
+    bool used;
+    bool reached; // The keymap has seen it
+};
+
+static struct latency_hist hists[LATENCY_STAGE_COUNT];
+static struct latency_key in_flight[LATENCY_IN_FLIGHT];
+static uint8_t in_flight_next;
+
+// Keycode waiting for its HID report
+static struct {
+    timing_t resolved;
+    uint32_t before_us; // dispatch + keymap time already spent
+    bool valid;
+} pending_report;
+
+static inline uint32_t cycles_to_us(timing_t start, timing_t end) {
+    return (uint32_t)(timing_cycles_to_ns(timing_cycles_get(&start, &end)) / NSEC_PER_USEC);
+}
+
+static void hist_add(enum latency_stage stage, uint32_t us) {
+    struct latency_hist *h = &hists[stage];
+    int bucket = us ? MIN(32 - __builtin_clz(us), LATENCY_BUCKETS - 1) : 0;
+
+    if (h->count == 0 || us < h->min_us) {
+        h->min_us = us;
+    }
+    h->max_us = MAX(h->max_us, us);
+    h->sum_us += us;
+    h->count++;
+    h->buckets[bucket]++;
+}
+
+void latency_trace_report_sent(enum zmk_transport transport) {
+    if (!pending_report.valid) {
+        return;
+    }
+
+    uint32_t report_us = cycles_to_us(pending_report.resolved, timing_counter_get());
+    bool usb = transport == ZMK_TRANSPORT_USB;
+
+    hist_add(usb ? LATENCY_STAGE_REPORT_USB : LATENCY_STAGE_REPORT_BLE, report_us);
+    hist_add(usb ? LATENCY_STAGE_TOTAL_USB : LATENCY_STAGE_TOTAL_BLE,
+             pending_report.before_us + report_us);
+    pending_report.valid = false;
+}
+
+int __real_zmk_event_manager_raise(zmk_event_t *event);
+
+// Linked with -Wl,--wrap=zmk_event_manager_raise: every press is stamped with the cycle
+// counter as it is raised, before combos or any other listener have seen it
+int __wrap_zmk_event_manager_raise(zmk_event_t *event) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(event);
+
+    if (ev && ev->state) {
+        struct latency_key *key = &in_flight[in_flight_next];
+
+        in_flight_next = (in_flight_next + 1) % LATENCY_IN_FLIGHT;
+        *key = (struct latency_key){
+            .timestamp = ev->timestamp,
+            .position = ev->position,
+            .raised = timing_counter_get(),
+            .used = true,
+        };
+    }
+
+    return __real_zmk_event_manager_raise(event);
+}
+
+static int latency_position_listener(const zmk_event_t *eh) {
+    const struct zmk_position_state_changed *ev = as_zmk_position_state_changed(eh);
+    if (!ev || !ev->state) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    for (int i = 0; i < LATENCY_IN_FLIGHT; i++) {
+        struct latency_key *key = &in_flight[i];
+
+        if (!key->used || key->reached || key->position != ev->position ||
+            key->timestamp != ev->timestamp) {
+            continue;
+        }
+
+        key->dispatched = timing_counter_get();
+        key->dispatch_us = cycles_to_us(key->raised, key->dispatched);
+        key->reached = true;
+        hist_add(LATENCY_STAGE_DISPATCH, key->dispatch_us);
+        break;
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+static int latency_keycode_listener(const zmk_event_t *eh) {
+    const struct zmk_keycode_state_changed *ev = as_zmk_keycode_state_changed(eh);
+    if (!ev || !ev->state) {
+        return ZMK_EV_EVENT_BUBBLE;
+    }
+
+    // Behaviors pass the originating position timestamp on to the keycode event
+    for (int i = 0; i < LATENCY_IN_FLIGHT; i++) {
+        struct latency_key *key = &in_flight[i];
+
+        if (!key->used || !key->reached || key->timestamp != ev->timestamp) {
+            continue;
+        }
+
+        timing_t now = timing_counter_get();
+        uint32_t keymap_us = cycles_to_us(key->dispatched, now);
+
+        hist_add(LATENCY_STAGE_KEYMAP, keymap_us);
+        pending_report.resolved = now;
+        pending_report.before_us = key->dispatch_us + keymap_us;
+        pending_report.valid = true;
+        key->used = false;
+        break;
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+static void latency_trace_print(void (*print)(void *ctx, const char *line), void *ctx) {
+    char line[96];
+
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        const struct latency_hist *h = &hists[s];
+
+        if (h->count == 0) {
+            continue;
+        }
+
+        snprintk(line, sizeof(line), "%s: n=%u min=%uus mean=%uus max=%uus", stage_names[s],
+                 h->count, h->min_us, (uint32_t)(h->sum_us / h->count), h->max_us);
+        print(ctx, line);
+
+        for (int b = 0; b < LATENCY_BUCKETS; b++) {
+            if (h->buckets[b] == 0) {
+                continue;
+            }
+            snprintk(line, sizeof(line), "  <%uus: %u", 1U << b, h->buckets[b]);
+            print(ctx, line);
+        }
+    }
+}
+
+static void latency_trace_reset(void) {
+    memset(hists, 0, sizeof(hists));
+    memset(in_flight, 0, sizeof(in_flight));
+    pending_report.valid = false;
+}
+
+#if CONFIG_DEEMEN17_LATENCY_TRACE_LOG_INTERVAL > 0
+static void log_line(void *ctx, const char *line) { LOG_INF("latency %s", line); }
+
+static void latency_log_work_cb(struct k_work *work);
+K_WORK_DELAYABLE_DEFINE(latency_log_work, latency_log_work_cb);
+
+static void latency_log_work_cb(struct k_work *work) {
+    latency_trace_print(log_line, NULL);
+    k_work_schedule(&latency_log_work, K_SECONDS(CONFIG_DEEMEN17_LATENCY_TRACE_LOG_INTERVAL));
+}
+#endif
+
+#if IS_ENABLED(CONFIG_SHELL)
+static void shell_line(void *ctx, const char *line) {
+    shell_print((const struct shell *)ctx, "%s", line);
+}
+
+static int cmd_latency_show(const struct shell *sh, size_t argc, char **argv) {
+    latency_trace_print(shell_line, (void *)sh);
+    return 0;
+}
+
+static int cmd_latency_reset(const struct shell *sh, size_t argc, char **argv) {
+    latency_trace_reset();
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_latency,
+                               SHELL_CMD(show, NULL, "Print latency histograms", cmd_latency_show),
+                               SHELL_CMD(reset, NULL, "Clear latency histograms", cmd_latency_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(latency, &sub_latency, "Key event latency tracing", NULL);
+#endif
+
+static int latency_trace_init(void) {
+    timing_init();
+    timing_start();
+    latency_trace_reset();
+
+#if CONFIG_DEEMEN17_LATENCY_TRACE_LOG_INTERVAL > 0
+    k_work_schedule(&latency_log_work, K_SECONDS(CONFIG_DEEMEN17_LATENCY_TRACE_LOG_INTERVAL));
+#endif
+
+    return 0;
+}
+
+// Subscriptions run in name order: "deemen17_" sorts before ZMK's "hid_listener",
+// so the keycode is timestamped before the report it causes is sent.
+DEEMEN17_LISTENER(deemen17_latency_position, latency_position_listener);
+ZMK_SUBSCRIPTION(deemen17_latency_position, zmk_position_state_changed);
+
+DEEMEN17_LISTENER(deemen17_latency_keycode, latency_keycode_listener);
+ZMK_SUBSCRIPTION(deemen17_latency_keycode, zmk_keycode_state_changed);
+
+SYS_INIT(latency_trace_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/init.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/timing/timing.h>
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/event_manager.h>
+
+#include <deemen17/listener_profile.h>
+
+// Cost of one listener for one event type
+struct listener_stats {
+    const char *listener;
+    const char *event;
+    uint32_t count;
+    uint32_t min_cycles;
+    uint32_t max_cycles;
+    uint64_t sum_cycles;
+};
+
+static struct listener_stats slots[CONFIG_DEEMEN17_LISTENER_PROFILE_SLOTS];
+static uint8_t slots_used;
+static uint32_t slots_full; // Calls not recorded because every slot was taken
+static struct k_spinlock lock;
+
+void listener_profile_record(const char *listener, const zmk_event_t *eh, timing_t start,
+                             timing_t end) {
+    uint32_t cycles = (uint32_t)timing_cycles_get(&start, &end);
+    const char *event = eh->event->name;
+    struct listener_stats *s = NULL;
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    // Names are string literals, each listener and event type has a single address
+    for (int i = 0; i < slots_used; i++) {
+        if (slots[i].listener == listener && slots[i].event == event) {
+            s = &slots[i];
+            break;
+        }
+    }
+
+    if (!s && slots_used < ARRAY_SIZE(slots)) {
+        s = &slots[slots_used++];
+        *s = (struct listener_stats){.listener = listener, .event = event};
+    }
+
+    if (!s) {
+        slots_full++;
+    } else {
+        if (s->count == 0 || cycles < s->min_cycles) {
+            s->min_cycles = cycles;
+        }
+        s->max_cycles = MAX(s->max_cycles, cycles);
+        s->sum_cycles += cycles;
+        s->count++;
+    }
+
+    k_spin_unlock(&lock, key);
+}
+
+static void listener_profile_print(void (*print)(void *ctx, const char *line), void *ctx) {
+    char line[112];
+    uint32_t full;
+    k_spinlock_key_t key;
+
+    // One slot copied at a time, printing is too slow to do with the lock held
+    for (int i = 0;; i++) {
+        struct listener_stats s;
+        bool done;
+
+        key = k_spin_lock(&lock);
+        done = i >= slots_used;
+        if (!done) {
+            s = slots[i];
+        }
+        k_spin_unlock(&lock, key);
+
+        if (done) {
+            break;
+        }
+
+        snprintk(line, sizeof(line), "%s/%s: n=%u min=%uns mean=%uns max=%uns", s.listener,
+                 s.event, s.count, (uint32_t)timing_cycles_to_ns(s.min_cycles),
+                 (uint32_t)timing_cycles_to_ns(s.sum_cycles / s.count),
+                 (uint32_t)timing_cycles_to_ns(s.max_cycles));
+        print(ctx, line);
+    }
+
+    key = k_spin_lock(&lock);
+    full = slots_full;
+    k_spin_unlock(&lock, key);
+
+    if (full) {
+        snprintk(line, sizeof(line), "%u calls not recorded, all slots taken", full);
+        print(ctx, line);
+    }
+}
+
+static void listener_profile_reset(void) {
+    k_spinlock_key_t key = k_spin_lock(&lock);
+
+    slots_used = 0;
+    slots_full = 0;
+    k_spin_unlock(&lock, key);
+}
+
+#if CONFIG_DEEMEN17_LISTENER_PROFILE_LOG_INTERVAL > 0
+static void log_line(void *ctx, const char *line) { LOG_INF("listener %s", line); }
+
+static void listener_log_work_cb(struct k_work *work);
+K_WORK_DELAYABLE_DEFINE(listener_log_work, listener_log_work_cb);
+
+static void listener_log_work_cb(struct k_work *work) {
+    listener_profile_print(log_line, NULL);
+    k_work_schedule(&listener_log_work, K_SECONDS(CONFIG_DEEMEN17_LISTENER_PROFILE_LOG_INTERVAL));
+}
+#endif
+
+#if IS_ENABLED(CONFIG_SHELL)
+static void shell_line(void *ctx, const char *line) {
+    shell_print((const struct shell *)ctx, "%s", line);
+}
+
+static int cmd_listeners_show(const struct shell *sh, size_t argc, char **argv) {
+    listener_profile_print(shell_line, (void *)sh);
+    return 0;
+}
+
+static int cmd_listeners_reset(const struct shell *sh, size_t argc, char **argv) {
+    listener_profile_reset();
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_listeners,
+                               SHELL_CMD(show, NULL, "Print listener costs", cmd_listeners_show),
+                               SHELL_CMD(reset, NULL, "Clear listener costs", cmd_listeners_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(listeners, &sub_listeners, "Event listener cost profiling", NULL);
+#endif
+
+static int listener_profile_init(void) {
+    timing_init();
+    timing_start();
+
+#if CONFIG_DEEMEN17_LISTENER_PROFILE_LOG_INTERVAL > 0
+    k_work_schedule(&listener_log_work, K_SECONDS(CONFIG_DEEMEN17_LISTENER_PROFILE_LOG_INTERVAL));
+#endif
+
+    return 0;
+}
+
+// Events raised during APPLICATION init are already timed
+SYS_INIT(listener_profile_init, POST_KERNEL, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
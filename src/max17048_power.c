@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/init.h>
+
+#include <zmk/event_manager.h>
+#include <zmk/usb.h>
+#include <zmk/events/usb_conn_state_changed.h>
+
+#include <deemen17/listener_profile.h>
+#include <deemen17/max17048.h>
+
+#define FUEL_GAUGE_NODE DT_INST(0, deemen17_max17048)
+
+// Tell the fuel gauge when USB powers the board so it samples the charge curve closely
+static void max17048_power_update(void) {
+    struct sensor_value powered = {.val1 = zmk_usb_is_powered()};
+
+    sensor_attr_set(DEVICE_DT_GET(FUEL_GAUGE_NODE), SENSOR_CHAN_GAUGE_STATE_OF_CHARGE,
+                    MAX17048_ATTR_EXTERNAL_POWER, &powered);
+}
+
+static int max17048_power_listener(const zmk_event_t *eh) {
+    max17048_power_update();
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_max17048_power, max17048_power_listener);
+ZMK_SUBSCRIPTION(deemen17_max17048_power, zmk_usb_conn_state_changed);
+
+static int max17048_power_init(void) {
+    max17048_power_update();
+    return 0;
+}
+
+SYS_INIT(max17048_power_init, APPLICATION, CONFIG_APPLICATION_INIT_PRIORITY);
@@ -0,0 +1,316 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Linked with -Wl,--wrap for the settings calls below, every settings write goes
+// through a small RAM cache. Repeated writes of a key only keep the last value and
+// the cache is written to flash in one batch once writes have been quiet for a
+// while, at the latest a fixed time after the first cached write, before soft off or
+// a reboot, and when the battery runs low. Flushes run on ZMK's low priority work
+// queue, never on the system one that key handling depends on.
+
+#include <string.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/reboot.h>
+
+#if IS_ENABLED(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+LOG_MODULE_DECLARE(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#include <zmk/workqueue.h>
+
+#if IS_ENABLED(CONFIG_ZMK_BATTERY_REPORTING)
+#include <zmk/event_manager.h>
+#include <zmk/events/battery_state_changed.h>
+
+#include <deemen17/listener_profile.h>
+#endif
+
+struct settings_cache_entry {
+    char name[SETTINGS_MAX_NAME_LEN + 1];
+    uint8_t value[CONFIG_DEEMEN17_SETTINGS_CACHE_VALUE_SIZE];
+    uint16_t len; // 0 deletes the key
+    bool dirty;
+};
+
+static struct settings_cache_entry entries[CONFIG_DEEMEN17_SETTINGS_CACHE_ENTRIES];
+static K_MUTEX_DEFINE(cache_lock);
+// Uptime of the first write still waiting, bounds how long a busy stream of writes
+// can hold the flush back
+static int64_t dirty_since_ms;
+
+static struct {
+    uint32_t writes;      // Calls to settings_save_one and settings_delete
+    uint32_t coalesced;   // Flash writes avoided: a value still waiting was replaced
+    uint32_t passthrough; // Writes that went straight to flash
+    uint32_t flushes;     // Batches written
+    uint32_t flushed;     // Keys written by those batches
+    uint32_t failed;      // Cached writes that failed and stayed dirty for a retry
+    uint64_t stall_us;    // Time spent in the real flash writes
+    uint32_t max_stall_us;
+} stats;
+
+int __real_settings_save_one(const char *name, const void *value, size_t val_len);
+int __real_settings_load(void);
+int __real_settings_load_subtree(const char *subtree);
+int __real_settings_load_subtree_direct(const char *subtree, settings_load_direct_cb cb,
+                                        void *param);
+FUNC_NORETURN void __real_sys_reboot(int type);
+void __real_zmk_pm_soft_off(void);
+
+static void settings_cache_flush_work_cb(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(flush_work, settings_cache_flush_work_cb);
+
+static void settings_cache_schedule(k_timeout_t delay) {
+    k_work_reschedule_for_queue(zmk_workqueue_lowprio_work_q(), &flush_work, delay);
+}
+
+static bool settings_cache_dirty_locked(void) {
+    for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+        if (entries[i].dirty) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static int settings_cache_write(const char *name, const void *value, size_t val_len) {
+    uint32_t start = k_cycle_get_32();
+    int err = __real_settings_save_one(name, value, val_len);
+    uint32_t us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+
+    stats.stall_us += us;
+    stats.max_stall_us = MAX(stats.max_stall_us, us);
+
+    if (err) {
+        LOG_ERR("Failed to write setting %s (err %d)", name, err);
+    }
+
+    return err;
+}
+
+// Called with the lock held. Entries that fail to write stay dirty and the flush is
+// retried after the quiet period, so a flash error does not lose the value.
+static int settings_cache_flush_locked(void) {
+    int ret = 0;
+    uint32_t count = 0;
+
+    for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+        struct settings_cache_entry *entry = &entries[i];
+        int err;
+
+        if (!entry->dirty) {
+            continue;
+        }
+
+        err = settings_cache_write(entry->name, entry->len ? entry->value : NULL, entry->len);
+        if (err) {
+            stats.failed++;
+            ret = ret ? ret : err;
+            continue;
+        }
+        entry->dirty = false;
+        count++;
+    }
+
+    if (count) {
+        stats.flushes++;
+        stats.flushed += count;
+        LOG_DBG("Flushed %u settings", count);
+    }
+
+    if (ret) {
+        dirty_since_ms = k_uptime_get();
+        settings_cache_schedule(K_MSEC(CONFIG_DEEMEN17_SETTINGS_CACHE_QUIET_MS));
+    }
+
+    return ret;
+}
+
+static int settings_cache_flush(void) {
+    int ret;
+
+    // Fatal error handlers reboot from interrupt context, where flash cannot be written
+    if (k_is_in_isr()) {
+        return -EWOULDBLOCK;
+    }
+
+    k_mutex_lock(&cache_lock, K_FOREVER);
+    k_work_cancel_delayable(&flush_work);
+    // Reschedules itself if some entry could not be written
+    ret = settings_cache_flush_locked();
+    k_mutex_unlock(&cache_lock);
+
+    return ret;
+}
+
+static void settings_cache_flush_work_cb(struct k_work *work) { settings_cache_flush(); }
+
+int __wrap_settings_save_one(const char *name, const void *value, size_t val_len) {
+    struct settings_cache_entry *entry = NULL;
+    int ret = 0;
+
+    k_mutex_lock(&cache_lock, K_FOREVER);
+    stats.writes++;
+
+    // Bonding keys are written by the BT host once per pairing; a lost write there
+    // costs a re-pair, so they go straight to flash
+    if (strncmp(name, "bt/", 3) == 0 || strlen(name) > SETTINGS_MAX_NAME_LEN ||
+        val_len > sizeof(entry->value)) {
+        stats.passthrough++;
+        ret = settings_cache_write(name, value, val_len);
+        k_mutex_unlock(&cache_lock);
+        return ret;
+    }
+
+    for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+        if (entries[i].dirty && strcmp(entries[i].name, name) == 0) {
+            entry = &entries[i];
+            stats.coalesced++;
+            break;
+        }
+        if (!entries[i].dirty && !entry) {
+            entry = &entries[i];
+        }
+    }
+
+    // Full: write out what is waiting and take the first entry that got free
+    if (!entry) {
+        ret = settings_cache_flush_locked();
+        for (int i = 0; i < ARRAY_SIZE(entries) && !entry; i++) {
+            if (!entries[i].dirty) {
+                entry = &entries[i];
+            }
+        }
+    }
+
+    // Still full, every write failed: try this one directly rather than drop it
+    if (!entry) {
+        stats.passthrough++;
+        ret = settings_cache_write(name, value, val_len);
+        k_mutex_unlock(&cache_lock);
+        return ret;
+    }
+
+    if (!settings_cache_dirty_locked()) {
+        dirty_since_ms = k_uptime_get();
+    }
+    if (!entry->dirty) {
+        strcpy(entry->name, name);
+    }
+    if (val_len) {
+        memcpy(entry->value, value, val_len);
+    }
+    entry->len = val_len;
+    entry->dirty = true;
+
+    settings_cache_schedule(K_TIMEOUT_ABS_MS(
+        MIN(k_uptime_get() + CONFIG_DEEMEN17_SETTINGS_CACHE_QUIET_MS,
+            dirty_since_ms + CONFIG_DEEMEN17_SETTINGS_CACHE_MAX_DELAY_MS)));
+    k_mutex_unlock(&cache_lock);
+
+    return ret;
+}
+
+// settings_delete() calls settings_save_one() from inside the settings library,
+// which the linker does not redirect, so deletes are routed through the cache here
+int __wrap_settings_delete(const char *name) { return __wrap_settings_save_one(name, NULL, 0); }
+
+// Anything read back from flash must see the cached values first
+int __wrap_settings_load(void) {
+    settings_cache_flush();
+    return __real_settings_load();
+}
+
+int __wrap_settings_load_subtree(const char *subtree) {
+    settings_cache_flush();
+    return __real_settings_load_subtree(subtree);
+}
+
+int __wrap_settings_load_subtree_direct(const char *subtree, settings_load_direct_cb cb,
+                                        void *param) {
+    settings_cache_flush();
+    return __real_settings_load_subtree_direct(subtree, cb, param);
+}
+
+FUNC_NORETURN void __wrap_sys_reboot(int type) {
+    settings_cache_flush();
+    __real_sys_reboot(type);
+}
+
+#if IS_ENABLED(CONFIG_ZMK_PM_SOFT_OFF)
+void __wrap_zmk_pm_soft_off(void) {
+    settings_cache_flush();
+    __real_zmk_pm_soft_off();
+}
+#endif
+
+#if IS_ENABLED(CONFIG_ZMK_BATTERY_REPORTING)
+static int settings_cache_battery_listener(const zmk_event_t *eh) {
+    const struct zmk_battery_state_changed *ev = as_zmk_battery_state_changed(eh);
+
+    if (ev->state_of_charge <= CONFIG_DEEMEN17_SETTINGS_CACHE_LOW_BATTERY) {
+        settings_cache_schedule(K_NO_WAIT);
+    }
+
+    return ZMK_EV_EVENT_BUBBLE;
+}
+
+DEEMEN17_LISTENER(deemen17_settings_cache, settings_cache_battery_listener);
+ZMK_SUBSCRIPTION(deemen17_settings_cache, zmk_battery_state_changed);
+#endif
+
+#if IS_ENABLED(CONFIG_SHELL)
+static int cmd_settings_cache_show(const struct shell *sh, size_t argc, char **argv) {
+    uint32_t dirty = 0;
+
+    k_mutex_lock(&cache_lock, K_FOREVER);
+    for (int i = 0; i < ARRAY_SIZE(entries); i++) {
+        if (entries[i].dirty) {
+            shell_print(sh, "dirty: %s (%u B)", entries[i].name, entries[i].len);
+            dirty++;
+        }
+    }
+
+    shell_print(sh, "writes: %u, avoided: %u, passthrough: %u", stats.writes, stats.coalesced,
+                stats.passthrough);
+    shell_print(sh, "flushes: %u, keys flushed: %u, failed: %u, dirty: %u", stats.flushes,
+                stats.flushed, stats.failed, dirty);
+    shell_print(sh, "flash stall: %u ms total, %u us max", (uint32_t)(stats.stall_us / 1000),
+                stats.max_stall_us);
+    k_mutex_unlock(&cache_lock);
+
+    return 0;
+}
+
+static int cmd_settings_cache_flush(const struct shell *sh, size_t argc, char **argv) {
+    return settings_cache_flush();
+}
+
+static int cmd_settings_cache_reset(const struct shell *sh, size_t argc, char **argv) {
+    k_mutex_lock(&cache_lock, K_FOREVER);
+    memset(&stats, 0, sizeof(stats));
+    k_mutex_unlock(&cache_lock);
+
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_settings_cache,
+                               SHELL_CMD(show, NULL, "Print settings cache counters",
+                                         cmd_settings_cache_show),
+                               SHELL_CMD(flush, NULL, "Write cached settings to flash now",
+                                         cmd_settings_cache_flush),
+                               SHELL_CMD(reset, NULL, "Clear settings cache counters",
+                                         cmd_settings_cache_reset),
+                               SHELL_SUBCMD_SET_END);
+
+SHELL_CMD_REGISTER(settingscache, &sub_settings_cache, "Settings write-behind cache", NULL);
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/sys/util.h>
+
+#include <deemen17/sound_request.h>
+
+// Each slot is a single atomic word:
+// [31] valid | [30:8] request time (ms, wrapping) | [7:0] argument
+#define SOUND_REQ_VALID BIT(31)
+#define SOUND_REQ_TIME_SHIFT 8
+#define SOUND_REQ_TIME_MASK BIT_MASK(23)
+#define SOUND_REQ_ARG_MASK BIT_MASK(8)
+
+bool sound_mailbox_post(struct sound_mailbox *mb, uint8_t sound_class, uint8_t arg,
+                        uint32_t now_ms) {
+    atomic_val_t req = SOUND_REQ_VALID | ((now_ms & SOUND_REQ_TIME_MASK) << SOUND_REQ_TIME_SHIFT) |
+                       (arg & SOUND_REQ_ARG_MASK);
+
+    if (sound_class >= mb->classes) {
+        return false;
+    }
+
+    atomic_inc(&mb->posted);
+    if (atomic_set(&mb->slots[sound_class], req) & SOUND_REQ_VALID) {
+        atomic_inc(&mb->coalesced);
+        return true;
+    }
+
+    return false;
+}
+
+bool sound_mailbox_take(struct sound_mailbox *mb, uint8_t min_class, uint32_t now_ms,
+                        uint8_t *sound_class, uint8_t *arg) {
+    for (int cls = mb->classes - 1; cls >= 0; cls--) {
+        atomic_val_t req = atomic_get(&mb->slots[cls]);
+
+        if (!(req & SOUND_REQ_VALID)) {
+            continue;
+        }
+
+        uint32_t requested = (req >> SOUND_REQ_TIME_SHIFT) & SOUND_REQ_TIME_MASK;
+        if (((now_ms - requested) & SOUND_REQ_TIME_MASK) > mb->max_age_ms) {
+            if (atomic_cas(&mb->slots[cls], req, 0)) {
+                atomic_inc(&mb->dropped);
+            }
+            continue;
+        }
+
+        if (cls < min_class) {
+            // Waits for the sound in progress to end, which takes again
+            return false;
+        }
+
+        if (!atomic_cas(&mb->slots[cls], req, 0)) {
+            // Replaced by a newer request of the same class, take that one instead
+            cls++;
+            continue;
+        }
+
+        *sound_class = cls;
+        *arg = req & SOUND_REQ_ARG_MASK;
+        return true;
+    }
+
+    return false;
+}
+
+void sound_bucket_init(struct sound_bucket *bucket, const struct sound_limit *limit,
+                       uint32_t now_ms) {
+    *bucket = (struct sound_bucket){
+        .stamp = now_ms,
+        .tokens = limit->burst,
+    };
+}
+
+bool sound_bucket_take(struct sound_bucket *bucket, const struct sound_limit *limit,
+                       uint32_t now_ms) {
+    uint32_t refills;
+
+    if (limit->burst == 0) {
+        return true;
+    }
+
+    refills = (now_ms - bucket->stamp) / limit->refill_ms;
+    if (refills >= limit->burst - bucket->tokens) {
+        bucket->tokens = limit->burst;
+        bucket->stamp = now_ms;
+    } else {
+        bucket->tokens += refills;
+        bucket->stamp += refills * limit->refill_ms;
+    }
+
+    if (bucket->tokens == 0) {
+        bucket->dropped++;
+        return false;
+    }
+
+    bucket->tokens--;
+    return true;
+}
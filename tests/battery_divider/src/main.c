@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/adc/adc_emul.h>
+#include <zephyr/drivers/gpio/gpio_emul.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/init.h>
+#include <zephyr/ztest.h>
+
+#include <deemen17/battery_divider.h>
+
+#define VBATT DT_NODELABEL(vbatt)
+#define POWER_PIN DT_GPIO_PIN(VBATT, power_gpios)
+
+// Battery to ADC input ratio of the overlay divider
+#define DIVIDER_RATIO 2
+// One 12 bit step of the 3.3 V reference is 0.8 mV at the input, 1.6 mV at the battery
+#define TOLERANCE_MV 4
+
+static const struct device *const divider = DEVICE_DT_GET(VBATT);
+static const struct device *const adc = DEVICE_DT_GET(DT_IO_CHANNELS_CTLR(VBATT));
+static const struct device *const power_port = DEVICE_DT_GET(DT_GPIO_CTLR(VBATT, power_gpios));
+
+static uint32_t battery_mv;
+static uint32_t conversions;
+static uint32_t unpowered_conversions;
+
+static int battery_input(const struct device *dev, unsigned int chan, void *data,
+                         uint32_t *result) {
+    conversions++;
+    if (gpio_emul_output_get(power_port, POWER_PIN) != 1) {
+        unpowered_conversions++;
+    }
+
+    *result = battery_mv / DIVIDER_RATIO;
+    return 0;
+}
+
+// The driver takes its first reading in its own init, so the battery input has to be
+// in place between the ADC's init and the sensor's. It starts out sagged.
+#define BATTERY_INPUT_INIT_PRIORITY 60
+BUILD_ASSERT(CONFIG_ADC_INIT_PRIORITY < BATTERY_INPUT_INIT_PRIORITY &&
+                 BATTERY_INPUT_INIT_PRIORITY < CONFIG_SENSOR_INIT_PRIORITY,
+             "The battery input must be set up before the divider reads it");
+
+static int battery_input_init(void) {
+    battery_mv = 3500;
+    return adc_emul_value_func_set(adc, DT_IO_CHANNELS_INPUT(VBATT), battery_input, NULL);
+}
+
+SYS_INIT(battery_input_init, POST_KERNEL, BATTERY_INPUT_INIT_PRIORITY);
+
+static uint32_t filtered_mv(void) {
+    struct sensor_value val;
+
+    zassert_ok(sensor_channel_get(divider, SENSOR_CHAN_GAUGE_VOLTAGE, &val));
+    return val.val1 * 1000 + val.val2 / 1000;
+}
+
+static void sample(uint32_t mv) {
+    battery_mv = mv;
+    zassert_ok(sensor_sample_fetch(divider));
+    zassert_equal(gpio_emul_output_get(power_port, POWER_PIN), 0, "divider left powered");
+}
+
+#define zassert_filtered(expected_mv, ...)                                                     \
+    zassert_within(filtered_mv(), expected_mv, TOLERANCE_MV, __VA_ARGS__)
+
+static void divider_after(void *fixture) { zassert_equal(unpowered_conversions, 0); }
+
+// The filter state carries over from test to test, ztest runs them in name order
+ZTEST_SUITE(battery_divider, NULL, NULL, NULL, divider_after, NULL);
+
+// A sagged first reading has nothing to be rejected against, the next one replaces it
+ZTEST(battery_divider, test_0_first_reading_in_sag) {
+    zassert_equal(conversions, 1);
+    zassert_filtered(3500);
+
+    sample(4000);
+    zassert_filtered(4000, "first reading stuck in the filter");
+}
+
+// Single outliers above the median do not move it, a majority does
+ZTEST(battery_divider, test_1_median_window) {
+    for (int i = 0; i < 3; i++) {
+        sample(4000);
+    }
+    zassert_filtered(4000);
+
+    sample(4200);
+    zassert_filtered(4000, "spike passed the median");
+
+    sample(4100);
+    zassert_filtered(4000);
+    sample(4100);
+    zassert_filtered(4100, "median did not follow the window");
+}
+
+// Up to two readings in a row below the median by more than sag-reject-mv are dropped,
+// a reading near the median starts the count anew
+ZTEST(battery_divider, test_2_sag_dropped) {
+    uint32_t before = conversions;
+
+    sample(3700);
+    sample(3700);
+    zassert_filtered(4100, "sag reached the filter");
+
+    sample(4100);
+    sample(3700);
+    zassert_filtered(4100, "sag count not reset");
+    sample(4100);
+
+    zassert_equal(conversions - before, 5, "dropped readings must still be sampled");
+}
+
+// A drop that lasts goes into the window after the second sag and the median follows
+// once it holds the majority
+ZTEST(battery_divider, test_3_lasting_drop) {
+    static const uint32_t expected_mv[] = {4100, 4100, 4100, 4100, 3700};
+
+    for (int i = 0; i < ARRAY_SIZE(expected_mv); i++) {
+        sample(3700);
+        zassert_filtered(expected_mv[i], "reading %d", i);
+    }
+
+    sample(3700);
+    zassert_filtered(3700);
+}
+
+// During a hold-off fetches serve the filtered value without converting
+ZTEST(battery_divider, test_4_hold_off) {
+    struct sensor_value hold_off = {.val1 = 1000};
+    uint32_t before = conversions;
+
+    zassert_ok(sensor_attr_set(divider, SENSOR_CHAN_GAUGE_VOLTAGE,
+                               BATTERY_DIVIDER_ATTR_HOLD_OFF, &hold_off));
+
+    sample(3000);
+    zassert_equal(conversions, before, "sampled during the hold-off");
+    zassert_filtered(3700);
+
+    k_sleep(K_MSEC(1001));
+    sample(3700);
+    zassert_equal(conversions, before + 1);
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/sensor.h>
+#include <zephyr/ztest.h>
+
+#include <deemen17/max17048.h>
+
+#include "max17048_emul.h"
+
+// Sampling intervals with the default DEEMEN17_MAX17048_INTERVAL_MIN_S/MAX_S
+#define MIN_S 60
+#define MAX_S 960
+
+BUILD_ASSERT(CONFIG_DEEMEN17_MAX17048_INTERVAL_MIN_S == MIN_S &&
+                 CONFIG_DEEMEN17_MAX17048_INTERVAL_MAX_S == MAX_S,
+             "The expected transaction counts assume the default intervals");
+
+static const struct device *const gauge = DEVICE_DT_GET(DT_NODELABEL(fuelgauge));
+
+static void set_external_power(bool on) {
+    struct sensor_value val = {.val1 = on};
+
+    zassert_ok(sensor_attr_set(gauge, SENSOR_CHAN_GAUGE_STATE_OF_CHARGE,
+                               MAX17048_ATTR_EXTERNAL_POWER, &val));
+}
+
+static uint32_t transfers(void) {
+    struct max17048_emul_stats stats;
+
+    max17048_emul_stats_get(&stats);
+    return stats.transfers;
+}
+
+// Back to a known schedule: one sample under external power, one after it with the
+// percentage unchanged, so the next sample is due in 2 * MIN_S
+static void gauge_before(void *fixture) {
+    max17048_emul_set(0xd000, 0x5480);
+    set_external_power(true);
+    k_sleep(K_MSEC(1));
+    set_external_power(false);
+    k_sleep(K_MSEC(1));
+}
+
+ZTEST_SUITE(max17048, NULL, NULL, gauge_before, NULL, NULL);
+
+// VCELL and SOC come in one write-then-read transaction
+ZTEST(max17048, test_burst_read) {
+    struct max17048_emul_stats stats;
+    struct sensor_value val;
+
+    max17048_emul_stats_get(&stats);
+    zassert_equal(stats.last_msgs, 2);
+    zassert_equal(stats.last_reg, 0x02);
+    zassert_equal(stats.last_read, 4);
+
+    zassert_ok(sensor_channel_get(gauge, SENSOR_CHAN_GAUGE_STATE_OF_CHARGE, &val));
+    zassert_equal(val.val1, 84);
+    zassert_equal(val.val2, 500000);
+    zassert_ok(sensor_channel_get(gauge, SENSOR_CHAN_GAUGE_VOLTAGE, &val));
+    zassert_equal(val.val1, 4);
+    zassert_equal(val.val2, 160000);
+}
+
+// Fetches are served from the cached reading
+ZTEST(max17048, test_fetch_from_cache) {
+    uint32_t before = transfers();
+    struct sensor_value val;
+
+    for (int i = 0; i < 100; i++) {
+        zassert_ok(sensor_sample_fetch(gauge));
+        zassert_ok(sensor_channel_get(gauge, SENSOR_CHAN_GAUGE_STATE_OF_CHARGE, &val));
+    }
+
+    zassert_equal(transfers(), before);
+}
+
+// A steady percentage backs off to the longest interval:
+// samples at 120, 360, 840, 1800 and 2760 s
+ZTEST(max17048, test_backoff_transactions_per_hour) {
+    uint32_t before = transfers();
+    uint32_t per_hour;
+
+    k_sleep(K_SECONDS(3600));
+    per_hour = transfers() - before;
+
+    TC_PRINT("steady on battery: %u I2C transactions per hour\n", per_hour);
+    zassert_equal(per_hour, 5);
+}
+
+// External power samples at the shortest interval from the moment it is reported
+ZTEST(max17048, test_external_power_transactions_per_hour) {
+    uint32_t before = transfers();
+    uint32_t per_hour;
+
+    set_external_power(true);
+    k_sleep(K_SECONDS(3600 - MIN_S / 2));
+    per_hour = transfers() - before;
+    set_external_power(false);
+
+    TC_PRINT("on external power: %u I2C transactions per hour\n", per_hour);
+    zassert_equal(per_hour, 3600 / MIN_S);
+}
+
+// A moving percentage halves the interval, a steady one doubles it again
+ZTEST(max17048, test_percent_change) {
+    uint32_t before = transfers();
+
+    max17048_emul_set(0xd000, 0x5580);
+
+    k_sleep(K_SECONDS(2 * MIN_S + 1));
+    zassert_equal(transfers() - before, 1, "change not sampled");
+
+    k_sleep(K_SECONDS(MIN_S));
+    zassert_equal(transfers() - before, 2, "interval not halved after a change");
+
+    k_sleep(K_SECONDS(2 * MIN_S - 2));
+    zassert_equal(transfers() - before, 2, "interval not doubled once steady");
+    k_sleep(K_SECONDS(2));
+    zassert_equal(transfers() - before, 3);
+}
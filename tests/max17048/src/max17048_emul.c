@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#define DT_DRV_COMPAT deemen17_max17048
+
+#include <string.h>
+
+#include <zephyr/device.h>
+#include <zephyr/drivers/emul.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/i2c_emul.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "max17048_emul.h"
+
+#define MAX17048_REG_VCELL 0x02
+#define MAX17048_REG_SOC 0x04
+#define MAX17048_REG_COUNT 0x100
+
+// 4.16 V and 84.5 %
+#define VCELL_DEFAULT 0xd000
+#define SOC_DEFAULT 0x5480
+
+static struct {
+    uint8_t regs[MAX17048_REG_COUNT];
+    struct max17048_emul_stats stats;
+} emul_state;
+
+void max17048_emul_set(uint16_t vcell, uint16_t soc) {
+    sys_put_be16(vcell, &emul_state.regs[MAX17048_REG_VCELL]);
+    sys_put_be16(soc, &emul_state.regs[MAX17048_REG_SOC]);
+}
+
+void max17048_emul_stats_get(struct max17048_emul_stats *stats) { *stats = emul_state.stats; }
+
+// Registers are read from the address written first, auto-incrementing
+static int max17048_emul_transfer(const struct emul *target, struct i2c_msg *msgs, int num_msgs,
+                                  int addr) {
+    uint8_t reg;
+
+    emul_state.stats.transfers++;
+    emul_state.stats.last_msgs = num_msgs;
+    emul_state.stats.last_read = 0;
+
+    if (num_msgs < 1 || (msgs[0].flags & I2C_MSG_READ) || msgs[0].len != 1) {
+        return -EIO;
+    }
+
+    reg = msgs[0].buf[0];
+    emul_state.stats.last_reg = reg;
+
+    for (int i = 1; i < num_msgs; i++) {
+        if (!(msgs[i].flags & I2C_MSG_READ) || reg + msgs[i].len > MAX17048_REG_COUNT) {
+            return -EIO;
+        }
+
+        memcpy(msgs[i].buf, &emul_state.regs[reg], msgs[i].len);
+        reg += msgs[i].len;
+        emul_state.stats.last_read += msgs[i].len;
+    }
+
+    return 0;
+}
+
+static const struct i2c_emul_api max17048_emul_api = {
+    .transfer = max17048_emul_transfer,
+};
+
+static int max17048_emul_init(const struct emul *target, const struct device *parent) {
+    max17048_emul_set(VCELL_DEFAULT, SOC_DEFAULT);
+    return 0;
+}
+
+EMUL_DT_INST_DEFINE(0, max17048_emul_init, NULL, NULL, &max17048_emul_api, NULL);
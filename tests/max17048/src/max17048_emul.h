@@ -0,0 +1,22 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// What the emulated gauge has seen on the bus
+struct max17048_emul_stats {
+    uint32_t transfers; // i2c_transfer() calls, one bus transaction each
+    uint32_t last_msgs; // Messages in the last transfer
+    uint8_t last_reg;   // Register address written by the last transfer
+    uint32_t last_read; // Bytes read by the last transfer
+};
+
+// Raw register values the gauge reports from now on
+void max17048_emul_set(uint16_t vcell, uint16_t soc);
+
+void max17048_emul_stats_get(struct max17048_emul_stats *stats);
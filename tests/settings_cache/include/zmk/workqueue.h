@@ -0,0 +1,12 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <zephyr/kernel.h>
+
+// Stand-in for ZMK's header, the test provides the queue
+struct k_work_q *zmk_workqueue_lowprio_work_q(void);
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/reboot.h>
+#include <zephyr/ztest.h>
+
+#include <zmk/workqueue.h>
+
+LOG_MODULE_REGISTER(zmk, CONFIG_ZMK_LOG_LEVEL);
+
+#define QUIET_MS CONFIG_DEEMEN17_SETTINGS_CACHE_QUIET_MS
+#define MAX_DELAY_MS CONFIG_DEEMEN17_SETTINGS_CACHE_MAX_DELAY_MS
+// Margin for a scheduled flush to have run
+#define SLACK_MS 100
+
+// The wrappers under test, called directly where the test stands in for the real
+// function behind them
+FUNC_NORETURN void __wrap_sys_reboot(int type);
+void __wrap_zmk_pm_soft_off(void);
+int __real_settings_load_subtree_direct(const char *subtree, settings_load_direct_cb cb,
+                                        void *param);
+
+// The settings destination, the NVS store on the flash simulator once initialised
+extern struct settings_store *settings_save_dst;
+
+static K_THREAD_STACK_DEFINE(lowprio_stack, 2048);
+static struct k_work_q lowprio_q;
+
+struct k_work_q *zmk_workqueue_lowprio_work_q(void) { return &lowprio_q; }
+
+// Every write that reaches flash passes through here on its way to the NVS store
+static struct settings_store *flash_store;
+static uint32_t flash_writes;
+static bool flash_fails;
+static bool last_write_on_lowprio;
+
+static int counting_save(struct settings_store *cs, const char *name, const char *value,
+                         size_t val_len) {
+    if (flash_fails) {
+        return -EIO;
+    }
+
+    flash_writes++;
+    last_write_on_lowprio = k_current_get() == &lowprio_q.thread;
+    return flash_store->cs_itf->csi_save(flash_store, name, value, val_len);
+}
+
+static const struct settings_store_itf counting_itf = {
+    .csi_save = counting_save,
+};
+
+static struct settings_store counting_store = {
+    .cs_itf = &counting_itf,
+};
+
+struct flash_value {
+    bool found;
+    uint32_t value;
+};
+
+static int flash_value_cb(const char *key, size_t len, settings_read_cb read_cb, void *cb_arg,
+                          void *param) {
+    struct flash_value *out = param;
+
+    // Exact match only, not keys further down the tree
+    if (key && *key) {
+        return 0;
+    }
+
+    out->found = read_cb(cb_arg, &out->value, sizeof(out->value)) == sizeof(out->value);
+    return 0;
+}
+
+// What is in flash, without the flush a settings load goes through
+static struct flash_value flash_read(const char *name) {
+    struct flash_value out = {0};
+
+    zassert_ok(__real_settings_load_subtree_direct(name, flash_value_cb, &out));
+    return out;
+}
+
+static void cache_write(const char *name, uint32_t value) {
+    zassert_ok(settings_save_one(name, &value, sizeof(value)));
+}
+
+static void *cache_setup(void) {
+    const struct flash_area *fa;
+
+    // The flash simulator's file outlives the process, start from blank flash
+    zassert_ok(flash_area_open(FIXED_PARTITION_ID(storage_partition), &fa));
+    zassert_ok(flash_area_erase(fa, 0, fa->fa_size));
+    flash_area_close(fa);
+
+    zassert_ok(settings_subsys_init());
+    flash_store = settings_save_dst;
+    settings_dst_register(&counting_store);
+
+    k_work_queue_start(&lowprio_q, lowprio_stack, K_THREAD_STACK_SIZEOF(lowprio_stack),
+                       K_LOWEST_APPLICATION_THREAD_PRIO, NULL);
+    return NULL;
+}
+
+// Nothing left waiting from the previous test
+static void cache_before(void *fixture) {
+    flash_fails = false;
+    zassert_ok(settings_load());
+}
+
+ZTEST_SUITE(settings_cache, NULL, cache_setup, cache_before, NULL, NULL);
+
+// A key written again while it waits reaches flash once, with its last value, from
+// the low priority queue
+ZTEST(settings_cache, test_coalesced) {
+    uint32_t before = flash_writes;
+
+    for (uint32_t i = 1; i <= 5; i++) {
+        cache_write("test/coalesced", i);
+        k_msleep(100);
+    }
+    zassert_equal(flash_writes, before);
+    zassert_false(flash_read("test/coalesced").found, "written before the quiet period");
+
+    k_msleep(QUIET_MS + SLACK_MS);
+    zassert_equal(flash_writes, before + 1);
+    zassert_equal(flash_read("test/coalesced").value, 5);
+    zassert_true(last_write_on_lowprio, "flushed outside the low priority queue");
+}
+
+// Writes every half quiet period never go quiet, they are flushed MAX_DELAY_MS after
+// the first
+BUILD_ASSERT(MAX_DELAY_MS % (QUIET_MS / 2) == 0 && MAX_DELAY_MS > QUIET_MS);
+
+ZTEST(settings_cache, test_max_delay) {
+    uint32_t before = flash_writes;
+
+    for (uint32_t i = 0; i < MAX_DELAY_MS / (QUIET_MS / 2); i++) {
+        if (i) {
+            k_msleep(QUIET_MS / 2);
+        }
+        cache_write("test/max_delay", i);
+    }
+    zassert_equal(flash_writes, before);
+
+    // The quiet period alone would hold it back until QUIET_MS / 2 later still
+    k_msleep(QUIET_MS / 2 + SLACK_MS);
+    zassert_equal(flash_writes, before + 1, "flush held back past the maximum delay");
+}
+
+// Reading settings back sees the cached value
+ZTEST(settings_cache, test_flush_before_direct_load) {
+    struct flash_value out = {0};
+    uint32_t before = flash_writes;
+
+    cache_write("test/direct", 7);
+    zassert_ok(settings_load_subtree_direct("test/direct", flash_value_cb, &out));
+
+    zassert_true(out.found);
+    zassert_equal(out.value, 7);
+    zassert_equal(flash_writes, before + 1);
+}
+
+// A failed write stays in the cache and is retried after the quiet period
+ZTEST(settings_cache, test_failed_write_kept_dirty) {
+    uint32_t before = flash_writes;
+
+    flash_fails = true;
+    cache_write("test/failed", 3);
+    k_msleep(QUIET_MS + SLACK_MS);
+    zassert_false(flash_read("test/failed").found);
+
+    flash_fails = false;
+    k_msleep(QUIET_MS + SLACK_MS);
+    zassert_equal(flash_writes, before + 1);
+    zassert_equal(flash_read("test/failed").value, 3, "failed write was dropped");
+}
+
+// A full cache writes out what is waiting to make room
+ZTEST(settings_cache, test_full) {
+    char name[] = "test/full0";
+    uint32_t before = flash_writes;
+
+    for (int i = 0; i < CONFIG_DEEMEN17_SETTINGS_CACHE_ENTRIES + 1; i++) {
+        name[sizeof(name) - 2] = '0' + i;
+        cache_write(name, i);
+    }
+
+    zassert_equal(flash_writes, before + CONFIG_DEEMEN17_SETTINGS_CACHE_ENTRIES);
+    zassert_equal(flash_read("test/full0").value, 0);
+}
+
+// Bonding keys are not cached
+ZTEST(settings_cache, test_bt_passthrough) {
+    uint32_t before = flash_writes;
+
+    cache_write("bt/test", 1);
+    zassert_equal(flash_writes, before + 1);
+    zassert_equal(flash_read("bt/test").value, 1);
+}
+
+static struct flash_value at_soft_off;
+
+void __real_zmk_pm_soft_off(void) { at_soft_off = flash_read("test/soft_off"); }
+
+ZTEST(settings_cache, test_flush_at_soft_off) {
+    cache_write("test/soft_off", 11);
+    __wrap_zmk_pm_soft_off();
+
+    zassert_true(at_soft_off.found, "not flushed before soft off");
+    zassert_equal(at_soft_off.value, 11);
+}
+
+// Ends the test from inside the wrapper, a reboot does not return
+FUNC_NORETURN void __real_sys_reboot(int type) {
+    struct flash_value out = flash_read("test/reboot");
+
+    zassert_true(out.found, "not flushed before the reboot");
+    zassert_equal(out.value, 13);
+    ztest_test_pass();
+    CODE_UNREACHABLE;
+}
+
+ZTEST(settings_cache, test_flush_at_reboot) {
+    cache_write("test/reboot", 13);
+    __wrap_sys_reboot(SYS_REBOOT_COLD);
+}
@@ -0,0 +1,22 @@
+#!/bin/sh
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Types the safety chord member keys on their own through the sim shield, once
+# with the chords as combos and once through the chord guard, and prints the
+# latency tracer's dispatch stage (position event to keymap) for both.
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+
+for variant in combos chord_guard; do
+    build=$("$here/run.sh" -n "chord_$variant" -t 16 -k "$here/chord/keys.txt" \
+        -o "$here/chord/$variant.overlay" -c "$here/chord/latency.conf")
+
+    echo "== $variant"
+    # The last dump covers the whole script; print its dispatch histogram
+    awk '/latency [a-z_]+:/ { in_dispatch = /latency dispatch:/; if (in_dispatch) dump = "" }
+         in_dispatch { sub(/.*latency /, ""); dump = dump $0 "\n" }
+         END { printf "%s", dump }' "$build/console.log"
+done
@@ -0,0 +1,35 @@
+#!/bin/sh
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Types the same presses through the sim shield with the buzzer click off and on
+# and prints the latency tracer's per-stage summary and the number of clicks
+# played for both. The sim has no USB or BLE transport, so reports are submitted
+# to no endpoint and land in the report_ble and total_ble stages. Sim time does
+# not advance while code runs: the numbers show whether the click delays the
+# report in scheduling, not what it costs in CPU time on the nRF52.
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+
+for variant in off on; do
+    set -- -n "click_$variant" -t 12 -k "$here/click/keys.txt" -c "$here/chord/latency.conf"
+    if [ "$variant" = on ]; then
+        set -- "$@" -c "$here/click/click.conf"
+    fi
+    build=$("$here/run.sh" "$@")
+
+    echo "== click $variant"
+    # The last dump covers the whole script
+    awk '/latency dispatch:/ { dump = "" }
+         /latency [a-z_]+: n=/ { sub(/.*latency /, ""); dump = dump $0 "\n" }
+         END { printf "%s", dump }' "$build/console.log"
+    clicks=$(grep -c "^[0-9]* sim_pwm_1 seq ch=0 steps=1 " "$build/trace.txt" || true)
+    echo "clicks=$clicks"
+
+    if [ "$variant" = on ] && [ "$clicks" -eq 0 ]; then
+        echo "no clicks played" >&2
+        exit 1
+    fi
+done
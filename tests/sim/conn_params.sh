@@ -0,0 +1,53 @@
+#!/bin/sh
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Runs the sim shield with BLE on nrf52_bsim against a BabbleSim central, once with
+# ZMK's own connection parameters and once with DEEMEN17_BLE_CONN_PARAMS, and
+# prints the parameter changes and the press-to-notification latency per set of
+# parameters for both. Needs BSIM_OUT_PATH and BSIM_COMPONENTS_PATH set up as for
+# Zephyr's bsim tests.
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+module=$(cd "$here/../.." && pwd)
+app=${ZMK_APP:-$module/../zmk/app}
+root=${BUILD_ROOT:-$module/build/sim}
+length=30000000 # us
+
+: "${BSIM_OUT_PATH:?BabbleSim is needed, set BSIM_OUT_PATH}"
+
+central=$root/conn_params_central
+west build -p -d "$central" -b nrf52_bsim -s "$here/conn_params/central" \
+    >"$central.build.log" 2>&1 || {
+    tail -n 40 "$central.build.log" >&2
+    exit 1
+}
+
+for variant in zmk adaptive; do
+    build=$root/conn_params_$variant
+    conf="$here/conn_params/peripheral.conf"
+    if [ "$variant" = adaptive ]; then
+        conf="$conf;$here/conn_params/adaptive.conf"
+    fi
+
+    west build -p -d "$build" -s "$app" -b nrf52_bsim -- \
+        -DSHIELD=de60_ble_rev1_sim \
+        -DZMK_EXTRA_MODULES="$module" \
+        -DEXTRA_CONF_FILE="$conf" >"$build.build.log" 2>&1 || {
+        tail -n 40 "$build.build.log" >&2
+        exit 1
+    }
+
+    sim_id=conn_params_${variant}_$$
+    (cd "$BSIM_OUT_PATH/bin" && ./bs_2G4_phy_v1 -s="$sim_id" -D=2 -sim_length="$length") \
+        >"$build/phy.log" 2>&1 &
+    "$central/zephyr/zephyr.exe" -s="$sim_id" -d=0 >"$build/central.log" 2>&1 &
+    "$build/zephyr/zephyr.exe" -s="$sim_id" -d=1 --trace-file="$build/trace.txt" \
+        --key-script="$here/conn_params/keys.txt" >"$build/console.log" 2>&1
+    wait
+
+    echo "== $variant"
+    awk -f "$here/conn_params/phase_latency.awk" "$build/trace.txt" "$build/central.log"
+done
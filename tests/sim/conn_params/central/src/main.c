@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// BabbleSim central for the connection parameter test: connects to the sim shield,
+// pairs, subscribes to the keyboard input report and prints, with its uptime in us,
+// every report notification and every connection parameter change. Both devices
+// start at simulated time 0, so the times line up with the keyboard's trace.
+//
+// Run with a flash file, the bond and the report subscription outlive the process:
+// the next run connects to directed advertising from the bonded keyboard and gets
+// notifications from the first one on, as a host does when a keyboard resumes.
+
+#include <string.h>
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/uuid.h>
+#include <zephyr/kernel.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/sys/printk.h>
+
+#define KEYBOARD_NAME "HKB Sim"
+
+static struct bt_conn *keyboard;
+static struct bt_gatt_discover_params discover_params;
+static struct bt_gatt_discover_params ccc_discover_params;
+static struct bt_gatt_subscribe_params subscribe_params;
+static bool subscribed;
+
+// Input report handles, saved next to the bond once subscribed
+static struct {
+    uint16_t value_handle;
+    uint16_t ccc_handle;
+} report;
+
+static uint64_t now_us(void) { return k_ticks_to_us_floor64(k_uptime_ticks()); }
+
+static void start_scan(void);
+
+static uint8_t report_notified(struct bt_conn *conn, struct bt_gatt_subscribe_params *params,
+                               const void *data, uint16_t length) {
+    if (data) {
+        printk("%llu notify len=%u\n", now_us(), length);
+    }
+
+    return BT_GATT_ITER_CONTINUE;
+}
+
+static void report_subscribed(struct bt_conn *conn, uint8_t err,
+                              struct bt_gatt_subscribe_params *params) {
+    if (err) {
+        printk("%llu error subscribed %u\n", now_us(), err);
+        return;
+    }
+
+    subscribed = true;
+    report.value_handle = params->value_handle;
+    report.ccc_handle = params->ccc_handle;
+    settings_save_one("central/report", &report, sizeof(report));
+}
+
+static int report_settings_set(const char *name, size_t len, settings_read_cb read_cb,
+                               void *cb_arg) {
+    if (len != sizeof(report) || read_cb(cb_arg, &report, sizeof(report)) != sizeof(report)) {
+        return -EINVAL;
+    }
+
+    return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(central_report, "central/report", NULL, report_settings_set,
+                               NULL, NULL);
+
+// The keyboard input report is the first HID report characteristic that notifies
+static uint8_t report_discovered(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+                                 struct bt_gatt_discover_params *params) {
+    const struct bt_gatt_chrc *chrc;
+    int err;
+
+    if (!attr) {
+        printk("%llu error no input report\n", now_us());
+        return BT_GATT_ITER_STOP;
+    }
+
+    chrc = attr->user_data;
+    if (!(chrc->properties & BT_GATT_CHRC_NOTIFY)) {
+        return BT_GATT_ITER_CONTINUE;
+    }
+
+    subscribe_params = (struct bt_gatt_subscribe_params){
+        .notify = report_notified,
+        .subscribe = report_subscribed,
+        .value = BT_GATT_CCC_NOTIFY,
+        .value_handle = chrc->value_handle,
+        .end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE,
+        .disc_params = &ccc_discover_params,
+    };
+
+    err = bt_gatt_subscribe(conn, &subscribe_params);
+    if (err) {
+        printk("%llu error subscribe %d\n", now_us(), err);
+    }
+
+    return BT_GATT_ITER_STOP;
+}
+
+static void connected(struct bt_conn *conn, uint8_t err) {
+    struct bt_conn_info info;
+
+    if (err) {
+        bt_conn_unref(keyboard);
+        keyboard = NULL;
+        start_scan();
+        return;
+    }
+
+    if (bt_conn_get_info(conn, &info) == 0) {
+        printk("%llu params interval=%u latency=%u\n", now_us(), info.le.interval,
+               info.le.latency);
+    }
+
+    // The HID reports need an encrypted link
+    bt_conn_set_security(conn, BT_SECURITY_L2);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason) {
+    printk("%llu disconnected reason=%u\n", now_us(), reason);
+
+    bt_conn_unref(keyboard);
+    keyboard = NULL;
+    start_scan();
+}
+
+static void security_changed(struct bt_conn *conn, bt_security_t level,
+                             enum bt_security_err err) {
+    if (err) {
+        printk("%llu error security %d\n", now_us(), err);
+        return;
+    }
+
+    // Subscriptions to a bonded keyboard are kept across connections
+    if (subscribed) {
+        return;
+    }
+
+    discover_params = (struct bt_gatt_discover_params){
+        .uuid = BT_UUID_HIDS_REPORT,
+        .func = report_discovered,
+        .start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE,
+        .end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE,
+        .type = BT_GATT_DISCOVER_CHARACTERISTIC,
+    };
+    bt_gatt_discover(conn, &discover_params);
+}
+
+static void param_updated(struct bt_conn *conn, uint16_t interval, uint16_t latency,
+                          uint16_t timeout) {
+    printk("%llu params interval=%u latency=%u\n", now_us(), interval, latency);
+}
+
+BT_CONN_CB_DEFINE(central_callbacks) = {
+    .connected = connected,
+    .disconnected = disconnected,
+    .security_changed = security_changed,
+    .le_param_updated = param_updated,
+};
+
+static bool name_matches(struct bt_data *data, void *user_data) {
+    bool *found = user_data;
+
+    if (data->type == BT_DATA_NAME_COMPLETE && data->data_len == strlen(KEYBOARD_NAME) &&
+        memcmp(data->data, KEYBOARD_NAME, data->data_len) == 0) {
+        *found = true;
+        return false;
+    }
+
+    return true;
+}
+
+static void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type,
+                         struct net_buf_simple *ad) {
+    bool found = false;
+
+    if (keyboard || (type != BT_GAP_ADV_TYPE_ADV_IND && type != BT_GAP_ADV_TYPE_ADV_DIRECT_IND)) {
+        return;
+    }
+
+    // Directed advertising is addressed to this central, only the bonded keyboard
+    // sends it
+    if (type == BT_GAP_ADV_TYPE_ADV_DIRECT_IND) {
+        found = true;
+    } else {
+        bt_data_parse(ad, name_matches, &found);
+    }
+    if (!found || bt_le_scan_stop()) {
+        return;
+    }
+
+    if (bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN, BT_LE_CONN_PARAM_DEFAULT, &keyboard)) {
+        start_scan();
+    }
+}
+
+// Registers the saved subscription for the bonded keyboard before it connects
+static void resubscribe(const struct bt_bond_info *info, void *user_data) {
+    subscribe_params = (struct bt_gatt_subscribe_params){
+        .notify = report_notified,
+        .value = BT_GATT_CCC_NOTIFY,
+        .value_handle = report.value_handle,
+        .ccc_handle = report.ccc_handle,
+    };
+
+    if (bt_gatt_resubscribe(BT_ID_DEFAULT, &info->addr, &subscribe_params) == 0) {
+        subscribed = true;
+    }
+}
+
+static void start_scan(void) {
+    int err = bt_le_scan_start(BT_LE_SCAN_ACTIVE, device_found);
+
+    if (err) {
+        printk("%llu error scan %d\n", now_us(), err);
+    }
+}
+
+int main(void) {
+    int err = bt_enable(NULL);
+
+    if (err) {
+        printk("error bt_enable %d\n", err);
+        return 0;
+    }
+
+    settings_load();
+    if (report.value_handle) {
+        bt_foreach_bond(BT_ID_DEFAULT, resubscribe, NULL);
+    }
+
+    start_scan();
+    return 0;
+}
@@ -0,0 +1,53 @@
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Reads the keyboard's sim trace, then the central's log, and reports key press to
+# report notification latency grouped by the connection parameters in effect at
+# the press. Interval is in 1.25 ms units, latency in skipped connection events.
+
+FNR == NR {
+    if ($2 == "key_matrix" && $5 == "pressed=1") {
+        press[++presses] = $1
+    }
+    next
+}
+
+$2 == "params" {
+    split($3, i, "=")
+    split($4, l, "=")
+    change_at[++changes] = $1
+    change_to[changes] = "interval=" i[2] " latency=" l[2]
+    print "params at_ms=" int($1 / 1000) " " change_to[changes]
+    next
+}
+
+$2 == "notify" {
+    notify[++notifies] = $1
+}
+
+END {
+    c = 0
+    n = 1
+    for (p = 1; p <= presses; p++) {
+        while (c < changes && change_at[c + 1] <= press[p]) c++
+        while (n <= notifies && notify[n] < press[p]) n++
+        if (c == 0 || n > notifies) {
+            unmatched++
+            continue
+        }
+
+        group = change_to[c]
+        lat = notify[n] - press[p]
+        count[group]++
+        sum[group] += lat
+        if (!(group in min) || lat < min[group]) min[group] = lat
+        if (lat > max[group]) max[group] = lat
+        n++
+    }
+
+    for (group in count) {
+        printf "%s presses=%d min_us=%d avg_us=%d max_us=%d\n", group, count[group],
+               min[group], sum[group] / count[group], max[group]
+    }
+    printf "unmatched_presses=%d\n", unmatched + 0
+}
@@ -0,0 +1,33 @@
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Checks that external power went off and back on, and that a lit frame reached the
+# strip after it came back. Without one the strip stays dark under a static effect.
+#
+#   awk -v port=sim_gpio_1 -v pin=12 -v strip=sim_led_strip -f frame_after_power.awk trace.txt
+
+$2 == port && $3 == "pin=" pin && $4 == "level=0" {
+    off_us = $1
+    frame_us = ""
+}
+
+$2 == port && $3 == "pin=" pin && $4 == "level=1" && off_us != "" {
+    on_us = $1
+    frame_us = ""
+}
+
+$2 == strip && $3 == "frame" && on_us != "" && frame_us == "" && $5 != "lit=0" {
+    frame_us = $1
+}
+
+END {
+    if (on_us == "") {
+        print "external power never went off and back on"
+        exit 1
+    }
+    if (frame_us == "") {
+        printf "%s: power back on, no lit frame sent after it\n", on_us
+        exit 1
+    }
+    printf "power back on at %s us, lit frame %d us later\n", on_us, frame_us - on_us
+}
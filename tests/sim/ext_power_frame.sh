@@ -0,0 +1,17 @@
+#!/bin/sh
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Runs solid underglow through the frame cache on an external power output, toggles
+# the power off and on with &ext_power EP_TOG and checks from the trace that a lit
+# frame is sent once power is back, without a refresh-ms.
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+
+build=$("$here/run.sh" -n ext_power_frame -t 5 -k "$here/ext_power/keys.txt" \
+    -o "$here/ext_power/underglow.overlay" -c "$here/ext_power/underglow.conf")
+
+awk -v port=sim_gpio_1 -v pin=12 -v strip=sim_led_strip \
+    -f "$here/ext_power/frame_after_power.awk" "$build/trace.txt"
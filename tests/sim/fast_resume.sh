@@ -0,0 +1,67 @@
+#!/bin/sh
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Runs the sim shield with BLE and fast resume on nrf52_bsim against a BabbleSim
+# central twice, both keeping their flash. The first run pairs. The second boots
+# as a wake from soft-off with the wakeup key pressed at the wake and prints the
+# time from that press to the first report notification at the central, next to
+# the keyboard's own log of it. Needs BSIM_OUT_PATH and BSIM_COMPONENTS_PATH set
+# up as for Zephyr's bsim tests.
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+module=$(cd "$here/../.." && pwd)
+app=${ZMK_APP:-$module/../zmk/app}
+root=${BUILD_ROOT:-$module/build/sim}
+length=10000000 # us
+
+: "${BSIM_OUT_PATH:?BabbleSim is needed, set BSIM_OUT_PATH}"
+
+central=$root/fast_resume_central
+west build -p -d "$central" -b nrf52_bsim -s "$here/conn_params/central" \
+    >"$central.build.log" 2>&1 || {
+    tail -n 40 "$central.build.log" >&2
+    exit 1
+}
+
+build=$root/fast_resume
+west build -p -d "$build" -s "$app" -b nrf52_bsim -- \
+    -DSHIELD=de60_ble_rev1_sim \
+    -DZMK_EXTRA_MODULES="$module" \
+    -DEXTRA_DTC_OVERLAY_FILE="$here/fast_resume/wake.overlay" \
+    -DEXTRA_CONF_FILE="$here/conn_params/peripheral.conf;$here/fast_resume/wake.conf" \
+    >"$build.build.log" 2>&1 || {
+    tail -n 40 "$build.build.log" >&2
+    exit 1
+}
+
+# run <pass> [keyboard options...]
+run() {
+    pass=$1
+    shift
+    sim_id=fast_resume_${pass}_$$
+
+    (cd "$BSIM_OUT_PATH/bin" && ./bs_2G4_phy_v1 -s="$sim_id" -D=2 -sim_length="$length") \
+        >"$build/$pass.phy.log" 2>&1 &
+    "$central/zephyr/zephyr.exe" -s="$sim_id" -d=0 -flash_file="$build/central.flash" \
+        >"$build/$pass.central.log" 2>&1 &
+    "$build/zephyr/zephyr.exe" -s="$sim_id" -d=1 -flash_file="$build/keyboard.flash" \
+        --trace-file="$build/$pass.trace.txt" "$@" >"$build/$pass.console.log" 2>&1
+    wait
+}
+
+rm -f "$build/central.flash" "$build/keyboard.flash"
+run pair
+run wake --wake-from-soft-off --key-script="$here/fast_resume/keys.txt"
+
+# From the wake press in the keyboard's trace to the first notification at the central
+awk 'FNR == NR { if (!pressed && $2 == "key_matrix" && $5 == "pressed=1") { pressed = 1; press = $1 }
+                 next }
+     $2 == "notify" { notify = $1; exit }
+     END {
+         if (!notify) { print "no report notified"; exit 1 }
+         printf "wake_press_to_report_us=%d\n", notify - press
+     }' "$build/wake.trace.txt" "$build/wake.central.log"
+grep -h "Woke from soft-off" "$build/wake.console.log" || true
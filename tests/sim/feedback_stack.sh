@@ -0,0 +1,19 @@
+#!/bin/sh
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Plays the startup chime and types the matrix key script on the sim shield with
+# the thread analyzer on, then prints the feedback thread's stack high-water mark
+# and the executor's worst-case job latency. native_sim frames are not Cortex-M
+# frames: size DEEMEN17_FEEDBACK_STACK_SIZE from DEEMEN17_FEEDBACK_STATS on the
+# board, and use this run to catch regressions between changes.
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+
+build=$("$here/run.sh" -n feedback_stack -t 12 -k "$here/matrix/keys.txt" \
+    -c "$here/feedback/stack.conf")
+
+grep -h " feedback *: STACK" "$build/console.log" | tail -n 1
+grep -h "Feedback worst case" "$build/console.log" | tail -n 1
@@ -0,0 +1,24 @@
+#!/bin/sh
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Boots the sim shield with no keys pressed and counts wakeups over one idle minute,
+# from 40 s after boot when ZMK has gone idle. ZMK's activity timer ticks once a
+# second on its own, so anything above 60 comes from the board modules.
+#
+#   idle_wakeups.sh [max_wakeups]
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+max=${1:-60}
+
+build=$("$here/run.sh" -n idle_wakeups -t 105 -c "$here/idle/idle.conf")
+
+awk -v max="$max" '$2 == "idle" {
+        split($3, w, "=")
+        print "wakeups per idle minute: " w[2]
+        found = 1
+        exit w[2] > max
+    }
+    END { if (!found) { print "no idle count in the trace"; exit 1 } }' "$build/trace.txt"
@@ -0,0 +1,42 @@
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Reads a sim trace and reports switch-to-position-event latency. Scripts must change
+# one switch at a time: a position event is matched to the last switch change of
+# the same direction before it, so chatter counts from its final edge.
+
+$2 == "key_matrix" {
+    split($5, s, "=")
+    switched[s[2]] = $1
+    changes++
+}
+
+$2 == "position" {
+    split($4, s, "=")
+    state = s[2]
+    if (!(state in switched)) {
+        unmatched++
+        next
+    }
+
+    lat = $1 - switched[state]
+    n[state]++
+    sum[state] += lat
+    if (!(state in min) || lat < min[state]) min[state] = lat
+    if (lat > max[state]) max[state] = lat
+    delete switched[state]
+}
+
+END {
+    label[1] = "press"
+    label[0] = "release"
+    for (state = 1; state >= 0; state--) {
+        if (n[state]) {
+            printf "%-8s events=%d min_us=%d avg_us=%d max_us=%d\n", label[state], n[state],
+                   min[state], sum[state] / n[state], max[state]
+        } else {
+            printf "%-8s events=0\n", label[state]
+        }
+    }
+    printf "switch_changes=%d unmatched_events=%d\n", changes, unmatched + 0
+}
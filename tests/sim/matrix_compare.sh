@@ -0,0 +1,28 @@
+#!/bin/sh
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Replays the same key script through the port matrix driver and the stock ZMK
+# matrix driver on native_sim and prints latency and GPIO reads per full scan for
+# both. Sim time does not advance while code runs, so reads, not scan time, are
+# what tells the two drivers apart here.
+#
+#   matrix_compare.sh [keys.txt]
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+keys=${1:-$here/matrix/keys.txt}
+
+port=$("$here/run.sh" -n matrix_port -k "$keys" -c "$here/matrix/reads.conf" \
+    -c "$here/matrix/stats.conf")
+stock=$("$here/run.sh" -n matrix_stock -k "$keys" -o "$here/matrix/stock.overlay" \
+    -c "$here/matrix/reads.conf")
+
+for build in "$port" "$stock"; do
+    echo "== $(basename "$build")"
+    awk -f "$here/key_latency.awk" "$build/trace.txt"
+    # Column 0 of kscan0 is sim_gpio0 pin 28
+    awk -v port=sim_gpio_0 -v pin=28 -f "$here/scan_reads.awk" "$build/trace.txt"
+    grep -h "full matrix scan" "$build/console.log" | tail -n 1 || true
+done
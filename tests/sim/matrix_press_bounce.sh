@@ -0,0 +1,23 @@
+#!/bin/sh
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Replays presses that bounce on contact through the port matrix driver with eager
+# press and the adaptive release window. Press bounce is not chatter, so releases
+# must keep being reported after the base 5 ms window instead of ratcheting to 40.
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+
+build=$("$here/run.sh" -n matrix_press_bounce -k "$here/matrix/press_bounce.txt" \
+    -o "$here/matrix/adaptive.overlay")
+
+awk -f "$here/key_latency.awk" "$build/trace.txt" | tee "$build/latency.txt"
+
+# Base window plus one scan period and scheduling slack
+awk '$1 == "release" { split($5, m, "="); if (m[2] >= 10000) bad = 1 } END { exit bad }' \
+    "$build/latency.txt" || {
+    echo "release window grew on press bounce" >&2
+    exit 1
+}
@@ -0,0 +1,16 @@
+#!/bin/sh
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Boots the sim shield with a backlight LED on the buzzer's shared-period PWM
+# instance and checks from the trace that the LED keeps its duty cycle while the
+# startup chime plays as a sequence on the buzzer channel.
+
+set -eu
+
+here=$(cd "$(dirname "$0")" && pwd)
+
+build=$("$here/run.sh" -n pwm_share -t 3 -o "$here/pwm_share/backlight.overlay" \
+    -c "$here/pwm_share/backlight.conf")
+
+awk -v dev=sim_pwm_1 -v led=1 -f "$here/pwm_share/led_hold.awk" "$build/trace.txt"
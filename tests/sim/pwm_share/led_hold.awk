@@ -0,0 +1,60 @@
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Checks that the LED channel of a shared-period instance keeps its duty cycle
+# through every step of every sequence played on the buzzer channel. Duty cycles
+# are compared in permille, allowing one for the rescaling to whole cycles.
+#
+#   awk -v dev=sim_pwm_1 -v led=1 -f led_hold.awk trace.txt
+
+function field(name,    i, kv) {
+    for (i = 3; i <= NF; i++) {
+        split($i, kv, "=")
+        if (kv[1] == name) {
+            return kv[2]
+        }
+    }
+    return ""
+}
+
+function permille(pulse, period) {
+    return period ? int(pulse * 1000 / period + 0.5) : 0
+}
+
+$2 == dev && $3 == "ch=" led {
+    duty = permille(field("pulse_ns"), field("period_ns"))
+    set = 1
+    if (playing && duty != seq_duty) {
+        printf "%s: LED output changed during a sequence\n", $1
+        bad = 1
+    }
+}
+
+$2 == dev && $3 == "seq" && field("steps") != "" {
+    playing = 1
+    seq_duty = duty
+    sequences++
+}
+
+$2 == dev && $3 == "seq" && ($NF == "done" || $NF == "stopped") {
+    playing = 0
+}
+
+$2 == dev && $3 == "seq" && $6 == "hold" && $7 == "ch=" led {
+    held = permille(field("pulse_ns"), field("period_ns"))
+    steps++
+    if (held < seq_duty - 1 || held > seq_duty + 1) {
+        printf "%s: step %s holds the LED at %d permille, expected %d\n", $1, field("step"),
+               held, seq_duty
+        bad = 1
+    }
+}
+
+END {
+    if (!set || !steps) {
+        printf "no LED output or no sequence step holding it (%d sequences)\n", sequences
+        exit 1
+    }
+    printf "%d sequences, %d steps, LED held at %d permille\n", sequences, steps, seq_duty
+    exit bad
+}
@@ -0,0 +1,55 @@
+#!/bin/sh
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Builds the de60_ble_rev1_sim shield on native_sim and replays a key script.
+#
+#   run.sh -n <name> [-k <keys.txt>] [-o <overlay>] [-c <conf>]... [-t <seconds>]
+#
+# The trace and console log land in $BUILD_ROOT/<name>/. ZMK_APP points at the zmk
+# app directory, by default the one next to this repo in the west workspace.
+
+set -eu
+
+module=$(cd "$(dirname "$0")/../.." && pwd)
+app=${ZMK_APP:-$module/../zmk/app}
+board=${SIM_BOARD:-native_sim}
+root=${BUILD_ROOT:-$module/build/sim}
+
+name=
+keys=
+overlay=
+conf=
+stop=10
+
+while getopts n:k:o:c:t: opt; do
+    case $opt in
+    n) name=$OPTARG ;;
+    k) keys=$(realpath "$OPTARG") ;;
+    o) overlay=$(realpath "$OPTARG") ;;
+    c) conf=${conf:+$conf;}$(realpath "$OPTARG") ;;
+    t) stop=$OPTARG ;;
+    *) exit 2 ;;
+    esac
+done
+
+if [ -z "$name" ]; then
+    echo "usage: $0 -n <name> [-k <keys>] [-o <overlay>] [-c <conf>] [-t <seconds>]" >&2
+    exit 2
+fi
+
+build=$root/$name
+
+west build -p -d "$build" -s "$app" -b "$board" -- \
+    -DSHIELD=de60_ble_rev1_sim \
+    -DZMK_EXTRA_MODULES="$module" \
+    ${overlay:+-DEXTRA_DTC_OVERLAY_FILE="$overlay"} \
+    ${conf:+-DEXTRA_CONF_FILE="$conf"} >"$build.build.log" 2>&1 || {
+    tail -n 40 "$build.build.log" >&2
+    exit 1
+}
+
+"$build/zephyr/zephyr.exe" -stop_at="$stop" \
+    --trace-file="$build/trace.txt" ${keys:+--key-script="$keys"} >"$build/console.log" 2>&1
+
+echo "$build"
@@ -0,0 +1,20 @@
+# Copyright (c) 2025 Deemen17 Works
+# SPDX-License-Identifier: MIT
+#
+# Reads a sim trace taken with CONFIG_DEEMEN17_GPIO_SIM_TRACE_READS and reports GPIO
+# input reads per full matrix scan. A scan starts on each rising edge of the first
+# column strobe, given as -v port=<gpio device> -v pin=<n>. Arming the matrix
+# interrupt drives every column too, so the count is slightly high for both drivers.
+
+$3 == "read" {
+    reads++
+    next
+}
+
+$2 == port && $3 == "pin=" pin && $4 == "level=1" {
+    scans++
+}
+
+END {
+    printf "scans=%d reads=%d reads_per_scan=%.1f\n", scans, reads, scans ? reads / scans : 0
+}
@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2025 Deemen17 Works
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <zephyr/ztest.h>
+
+#include <deemen17/sound_request.h>
+
+// Same layout as the rev1 buzzer: classes in ascending priority, 1 s maximum wait
+enum {
+    CLASS_STARTUP,
+    CLASS_CONNECTION,
+    CLASS_ENDPOINT,
+    CLASS_PROFILE,
+    CLASS_COUNT,
+};
+
+#define MAX_AGE_MS 1000
+
+static struct sound_mailbox mb;
+
+static void mailbox_before(void *fixture) {
+    mb = (struct sound_mailbox)SOUND_MAILBOX_INITIALIZER(CLASS_COUNT, MAX_AGE_MS);
+}
+
+ZTEST_SUITE(sound_mailbox, NULL, NULL, mailbox_before, NULL, NULL);
+
+ZTEST(sound_mailbox, test_empty) {
+    uint8_t cls, arg;
+
+    zassert_false(sound_mailbox_take(&mb, 0, 0, &cls, &arg));
+}
+
+// A storm of one class collapses into its latest request
+ZTEST(sound_mailbox, test_coalescing) {
+    uint8_t cls, arg;
+
+    zassert_false(sound_mailbox_post(&mb, CLASS_PROFILE, 0, 100));
+    for (uint8_t i = 1; i <= 50; i++) {
+        zassert_true(sound_mailbox_post(&mb, CLASS_PROFILE, i % 5, 100 + i));
+    }
+
+    zassert_equal(atomic_get(&mb.posted), 51);
+    zassert_equal(atomic_get(&mb.coalesced), 50);
+
+    zassert_true(sound_mailbox_take(&mb, 0, 200, &cls, &arg));
+    zassert_equal(cls, CLASS_PROFILE);
+    zassert_equal(arg, 50 % 5);
+    zassert_false(sound_mailbox_take(&mb, 0, 200, &cls, &arg));
+}
+
+// Each class keeps its own slot, a storm of one does not replace another
+ZTEST(sound_mailbox, test_classes_independent) {
+    uint8_t cls, arg;
+
+    sound_mailbox_post(&mb, CLASS_CONNECTION, 7, 0);
+    for (int i = 0; i < 20; i++) {
+        sound_mailbox_post(&mb, CLASS_ENDPOINT, i & 1, i);
+    }
+
+    zassert_true(sound_mailbox_take(&mb, 0, 30, &cls, &arg));
+    zassert_equal(cls, CLASS_ENDPOINT);
+    zassert_equal(arg, 1);
+    zassert_true(sound_mailbox_take(&mb, 0, 30, &cls, &arg));
+    zassert_equal(cls, CLASS_CONNECTION);
+    zassert_equal(arg, 7);
+}
+
+ZTEST(sound_mailbox, test_priority_order) {
+    uint8_t cls, arg;
+
+    sound_mailbox_post(&mb, CLASS_STARTUP, 0, 0);
+    sound_mailbox_post(&mb, CLASS_PROFILE, 2, 1);
+    sound_mailbox_post(&mb, CLASS_CONNECTION, 0, 2);
+
+    zassert_true(sound_mailbox_take(&mb, 0, 10, &cls, &arg));
+    zassert_equal(cls, CLASS_PROFILE);
+    zassert_true(sound_mailbox_take(&mb, 0, 10, &cls, &arg));
+    zassert_equal(cls, CLASS_CONNECTION);
+    zassert_true(sound_mailbox_take(&mb, 0, 10, &cls, &arg));
+    zassert_equal(cls, CLASS_STARTUP);
+}
+
+// While a sound plays, lower classes wait and the same or higher classes preempt it
+ZTEST(sound_mailbox, test_priority_preemption) {
+    uint8_t cls, arg;
+
+    sound_mailbox_post(&mb, CLASS_ENDPOINT, 1, 0);
+    zassert_true(sound_mailbox_take(&mb, 0, 0, &cls, &arg));
+    zassert_equal(cls, CLASS_ENDPOINT);
+
+    // Endpoint melody playing: a connection request has to wait for it
+    sound_mailbox_post(&mb, CLASS_CONNECTION, 0, 10);
+    zassert_false(sound_mailbox_take(&mb, CLASS_ENDPOINT, 20, &cls, &arg));
+
+    // A profile switch preempts it
+    sound_mailbox_post(&mb, CLASS_PROFILE, 3, 30);
+    zassert_true(sound_mailbox_take(&mb, CLASS_ENDPOINT, 30, &cls, &arg));
+    zassert_equal(cls, CLASS_PROFILE);
+    zassert_equal(arg, 3);
+
+    // So does a newer request of the class playing
+    sound_mailbox_post(&mb, CLASS_PROFILE, 4, 40);
+    zassert_true(sound_mailbox_take(&mb, CLASS_PROFILE, 40, &cls, &arg));
+    zassert_equal(arg, 4);
+
+    // Once the melody ends the waiting connection request still plays
+    zassert_true(sound_mailbox_take(&mb, 0, 300, &cls, &arg));
+    zassert_equal(cls, CLASS_CONNECTION);
+    zassert_equal(atomic_get(&mb.dropped), 0);
+}
+
+// Requests left waiting longer than the maximum age are dropped, not played late
+ZTEST(sound_mailbox, test_stale_drop) {
+    uint8_t cls, arg;
+
+    sound_mailbox_post(&mb, CLASS_CONNECTION, 0, 0);
+    sound_mailbox_post(&mb, CLASS_ENDPOINT, 0, 500);
+
+    // At exactly the maximum age a request is still played
+    zassert_true(sound_mailbox_take(&mb, 0, MAX_AGE_MS + 500, &cls, &arg));
+    zassert_equal(cls, CLASS_ENDPOINT);
+
+    zassert_false(sound_mailbox_take(&mb, 0, MAX_AGE_MS + 1, &cls, &arg));
+    zassert_equal(atomic_get(&mb.dropped), 1);
+}
+
+// A stale request blocked behind a playing melody is dropped on the next take
+ZTEST(sound_mailbox, test_stale_drop_while_playing) {
+    uint8_t cls, arg;
+
+    sound_mailbox_post(&mb, CLASS_STARTUP, 0, 0);
+    zassert_false(sound_mailbox_take(&mb, CLASS_PROFILE, 400, &cls, &arg));
+    zassert_false(sound_mailbox_take(&mb, 0, 1200, &cls, &arg));
+    zassert_equal(atomic_get(&mb.dropped), 1);
+}
+
+// Request times are kept modulo 2^23 ms, ages stay right across the wrap
+ZTEST(sound_mailbox, test_time_wrap) {
+    uint32_t wrap = BIT(23);
+    uint8_t cls, arg;
+
+    sound_mailbox_post(&mb, CLASS_PROFILE, 1, wrap - 100);
+    zassert_true(sound_mailbox_take(&mb, 0, wrap + 200, &cls, &arg));
+
+    sound_mailbox_post(&mb, CLASS_PROFILE, 1, wrap - 100);
+    zassert_false(sound_mailbox_take(&mb, 0, wrap + MAX_AGE_MS, &cls, &arg));
+}
+
+ZTEST(sound_mailbox, test_class_out_of_range) {
+    uint8_t cls, arg;
+
+    zassert_false(sound_mailbox_post(&mb, CLASS_COUNT, 0, 0));
+    zassert_equal(atomic_get(&mb.posted), 0);
+    zassert_false(sound_mailbox_take(&mb, 0, 0, &cls, &arg));
+}
+
+// Token buckets, one per class as in the buzzer
+static const struct sound_limit limits[CLASS_COUNT] = {
+    [CLASS_STARTUP] = {0, 0},
+    [CLASS_CONNECTION] = {2, 5000},
+    [CLASS_ENDPOINT] = {3, 1000},
+    [CLASS_PROFILE] = {3, 500},
+};
+
+static struct sound_bucket buckets[CLASS_COUNT];
+
+// Buckets start full at a non-zero time, as at boot
+#define START_MS 1234
+
+static void bucket_before(void *fixture) {
+    for (int i = 0; i < CLASS_COUNT; i++) {
+        sound_bucket_init(&buckets[i], &limits[i], START_MS);
+    }
+}
+
+ZTEST_SUITE(sound_bucket, NULL, NULL, bucket_before, NULL, NULL);
+
+static bool take(int cls, uint32_t now_ms) {
+    return sound_bucket_take(&buckets[cls], &limits[cls], now_ms);
+}
+
+// A full bucket lets burst sounds through back to back, then drops
+ZTEST(sound_bucket, test_burst) {
+    for (int i = 0; i < limits[CLASS_PROFILE].burst; i++) {
+        zassert_true(take(CLASS_PROFILE, START_MS), "sound %d of the burst dropped", i);
+    }
+
+    zassert_false(take(CLASS_PROFILE, START_MS));
+    zassert_false(take(CLASS_PROFILE, START_MS + 499));
+    zassert_equal(buckets[CLASS_PROFILE].dropped, 2);
+}
+
+// One token comes back per refill period, partial periods carry over
+ZTEST(sound_bucket, test_refill) {
+    uint32_t now = START_MS;
+
+    while (take(CLASS_PROFILE, now)) {
+    }
+
+    now += 300;
+    zassert_false(take(CLASS_PROFILE, now));
+    now += 200;
+    zassert_true(take(CLASS_PROFILE, now), "refill after 500 ms");
+    zassert_false(take(CLASS_PROFILE, now));
+
+    // Two periods bring back two tokens
+    now += 1000;
+    zassert_true(take(CLASS_PROFILE, now));
+    zassert_true(take(CLASS_PROFILE, now));
+    zassert_false(take(CLASS_PROFILE, now));
+}
+
+// A long quiet period refills up to burst, not beyond
+ZTEST(sound_bucket, test_refill_capped) {
+    uint32_t now = START_MS;
+
+    while (take(CLASS_ENDPOINT, now)) {
+    }
+
+    now += 60000;
+    for (int i = 0; i < limits[CLASS_ENDPOINT].burst; i++) {
+        zassert_true(take(CLASS_ENDPOINT, now));
+    }
+    zassert_false(take(CLASS_ENDPOINT, now));
+}
+
+// Refills stay right when the millisecond uptime wraps
+ZTEST(sound_bucket, test_refill_time_wrap) {
+    uint32_t now = UINT32_MAX - 200;
+
+    sound_bucket_init(&buckets[CLASS_PROFILE], &limits[CLASS_PROFILE], now);
+    while (take(CLASS_PROFILE, now)) {
+    }
+
+    now += 500;
+    zassert_true(take(CLASS_PROFILE, now), "refill across the wrap");
+    zassert_false(take(CLASS_PROFILE, now));
+}
+
+// A storm in one class drains only its own bucket
+ZTEST(sound_bucket, test_no_starvation) {
+    uint32_t now = START_MS;
+
+    for (int i = 0; i < 100; i++) {
+        take(CLASS_PROFILE, now + i * 10);
+    }
+    zassert_true(buckets[CLASS_PROFILE].dropped > 0);
+
+    now += 1000;
+    for (int i = 0; i < limits[CLASS_CONNECTION].burst; i++) {
+        zassert_true(take(CLASS_CONNECTION, now));
+    }
+    for (int i = 0; i < limits[CLASS_ENDPOINT].burst; i++) {
+        zassert_true(take(CLASS_ENDPOINT, now));
+    }
+    zassert_equal(buckets[CLASS_CONNECTION].dropped, 0);
+    zassert_equal(buckets[CLASS_ENDPOINT].dropped, 0);
+}
+
+// Burst 0 never limits
+ZTEST(sound_bucket, test_unlimited) {
+    for (int i = 0; i < 1000; i++) {
+        zassert_true(take(CLASS_STARTUP, START_MS));
+    }
+    zassert_equal(buckets[CLASS_STARTUP].dropped, 0);
+}